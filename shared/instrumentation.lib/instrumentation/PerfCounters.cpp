@@ -0,0 +1,103 @@
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace instrumentation {
+
+auto Sample::operator+=(const This& o) -> This& {
+    wallTime += o.wallTime;
+    for (auto i = size_t{}; i < counterCount; i++) {
+        if (counts[i] && o.counts[i])
+            counts[i] = counts[i].value() + o.counts[i].value();
+        else
+            counts[i] = {}; // one side is unknown
+    }
+    return *this;
+}
+
+auto Sample::operator-(const This& o) const -> This {
+    auto r = This{};
+    r.wallTime = wallTime - o.wallTime;
+    for (auto i = size_t{}; i < counterCount; i++) {
+        if (counts[i] && o.counts[i]) r.counts[i] = counts[i].value() - o.counts[i].value();
+    }
+    return r;
+}
+
+#ifdef __linux__
+
+namespace {
+
+constexpr uint64_t perfConfig[counterCount] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+auto openCounter(uint64_t config) -> int {
+    auto attr = perf_event_attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1; // allowed with perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    // pid = 0 / cpu = -1 => calling thread on any cpu
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters()
+    : m_start(Clock::now()) {
+    for (auto i = size_t{}; i < counterCount; i++) {
+        m_fds[i] = openCounter(perfConfig[i]);
+        if (m_fds[i] >= 0) ioctl(m_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (auto fd : m_fds)
+        if (fd >= 0) close(fd);
+}
+
+auto PerfCounters::read() const -> Sample {
+    auto r = Sample{};
+    r.wallTime = Clock::now() - m_start;
+    for (auto i = size_t{}; i < counterCount; i++) {
+        if (m_fds[i] < 0) continue;
+        auto value = uint64_t{};
+        if (::read(m_fds[i], &value, sizeof(value)) == sizeof(value)) r.counts[i] = value;
+    }
+    return r;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+    : m_start(Clock::now()) {
+    m_fds.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+auto PerfCounters::read() const -> Sample {
+    auto r = Sample{};
+    r.wallTime = Clock::now() - m_start;
+    return r;
+}
+
+#endif
+
+bool PerfCounters::anyAvailable() const {
+    for (auto fd : m_fds)
+        if (fd >= 0) return true;
+    return false;
+}
+
+} // namespace instrumentation
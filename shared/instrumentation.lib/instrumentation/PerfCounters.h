@@ -0,0 +1,61 @@
+#pragma once
+#include "meta/Optional.h"
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+
+namespace instrumentation {
+
+/// hardware counters we are interested in
+enum class Counter {
+    cycles,
+    instructions,
+    cacheMisses,
+    branchMisses,
+};
+constexpr auto counterCount = size_t{4};
+
+using OptCount = meta::Optional<uint64_t>;
+using Counts = std::array<OptCount, counterCount>;
+using Clock = std::chrono::steady_clock;
+
+/// measurement of a time interval
+// counters are empty if they are not available
+struct Sample {
+    using This = Sample;
+    Clock::duration wallTime{};
+    Counts counts{};
+
+    auto operator[](Counter c) const -> OptCount { return counts[static_cast<size_t>(c)]; }
+
+    auto operator+=(const This& o) -> This&;
+    auto operator-(const This& o) const -> This;
+};
+
+/// Linux perf_event_open counters of the calling thread
+// counters run freely after construction - take differences of read()
+// degrades gracefully: counters that cannot be opened (eg. in containers or other platforms) stay empty
+struct PerfCounters {
+    using This = PerfCounters;
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const This&) = delete;
+    PerfCounters(This&&) = delete;
+    auto operator=(const This&) -> This& = delete;
+    auto operator=(This&&) -> This& = delete;
+
+    [[nodiscard]] bool isAvailable(Counter c) const { return m_fds[static_cast<size_t>(c)] >= 0; }
+    [[nodiscard]] bool anyAvailable() const;
+
+    /// current totals (wall time is relative to construction)
+    [[nodiscard]] auto read() const -> Sample;
+
+private:
+    std::array<int, counterCount> m_fds{};
+    Clock::time_point m_start{};
+};
+
+} // namespace instrumentation
@@ -0,0 +1,17 @@
+#include "Profile.h"
+
+#include <algorithm>
+
+namespace instrumentation {
+
+void Profile::add(const char* name, const Sample& sample) {
+    auto it = std::find_if(m_phases.begin(), m_phases.end(), [&](const Phase& p) { return p.name == name; });
+    if (it == m_phases.end()) {
+        m_phases.push_back(Phase{name, sample, 1});
+        return;
+    }
+    it->total += sample;
+    it->count++;
+}
+
+} // namespace instrumentation
@@ -0,0 +1,57 @@
+#pragma once
+#include "PerfCounters.h"
+
+#include <string>
+#include <vector>
+
+namespace instrumentation {
+
+/// accumulated samples of one named phase
+struct Phase {
+    std::string name{};
+    Sample total{};
+    size_t count{};
+};
+
+/// collects samples per phase in order of first appearance
+// not thread safe - use one profile per thread
+struct Profile {
+    void add(const char* name, const Sample& sample);
+
+    [[nodiscard]] auto phases() const -> const std::vector<Phase>& { return m_phases; }
+    [[nodiscard]] auto counters() const -> const PerfCounters& { return m_counters; }
+
+private:
+    PerfCounters m_counters{};
+    std::vector<Phase> m_phases{};
+};
+
+/// measures the lifetime of this object as a phase
+// nothing is measured if profile is nullptr (instrumentation is opt-in)
+struct ScopedPhase {
+    ScopedPhase(Profile* profile, const char* name)
+        : m_profile(profile)
+        , m_name(name) {
+        if (m_profile) m_start = m_profile->counters().read();
+    }
+    ~ScopedPhase() {
+        if (m_profile) m_profile->add(m_name, m_profile->counters().read() - m_start);
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    Profile* m_profile{};
+    const char* m_name{};
+    Sample m_start{};
+};
+
+/// measures one call of f (eg. a benchmark iteration)
+template<class F>
+decltype(auto) measure(Profile* profile, const char* name, F&& f) {
+    auto phase = ScopedPhase{profile, name};
+    return f();
+}
+
+} // namespace instrumentation
@@ -0,0 +1,37 @@
+#pragma once
+#include "Profile.h"
+
+#include <iomanip>
+#include <ostream>
+
+namespace instrumentation {
+
+inline auto operator<<(std::ostream& out, const Phase& phase) -> std::ostream& {
+    auto column = [&](OptCount c) {
+        out << std::setw(16);
+        if (c)
+            out << c.value();
+        else
+            out << "n/a";
+    };
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(phase.total.wallTime).count();
+    out << std::left << std::setw(12) << phase.name << std::right << std::setw(8) << phase.count;
+    out << std::setw(14) << micros;
+    column(phase.total[Counter::cycles]);
+    column(phase.total[Counter::instructions]);
+    column(phase.total[Counter::cacheMisses]);
+    column(phase.total[Counter::branchMisses]);
+    return out;
+}
+
+inline auto operator<<(std::ostream& out, const Profile& profile) -> std::ostream& {
+    out << std::left << std::setw(12) << "phase";
+    out << std::right << std::setw(8) << "count" << std::setw(14) << "wall [us]";
+    out << std::setw(16) << "cycles" << std::setw(16) << "instructions";
+    out << std::setw(16) << "cache misses" << std::setw(16) << "branch misses" << '\n';
+    for (const auto& phase : profile.phases()) out << phase << '\n';
+    if (!profile.counters().anyAvailable()) out << "note: hardware counters are not available\n";
+    return out;
+}
+
+} // namespace instrumentation
@@ -0,0 +1,37 @@
+#include "Profile.h"
+
+#include "gtest/gtest.h"
+
+using namespace instrumentation;
+
+TEST(profile, phases) {
+    auto profile = Profile{};
+    for (auto i = 0; i < 3; i++) {
+        auto outer = ScopedPhase{&profile, "outer"};
+        measure(&profile, "inner", [] {});
+    }
+
+    const auto& phases = profile.phases();
+    ASSERT_EQ(phases.size(), 2u);
+    EXPECT_EQ(phases[0].name, "inner"); // inner phase finishes first
+    EXPECT_EQ(phases[0].count, 3u);
+    EXPECT_EQ(phases[1].name, "outer");
+    EXPECT_EQ(phases[1].count, 3u);
+    EXPECT_LE(phases[0].total.wallTime, phases[1].total.wallTime);
+}
+
+TEST(profile, disabled) {
+    auto result = measure(nullptr, "nothing", [] { return 42; });
+    ASSERT_EQ(result, 42);
+}
+
+TEST(perfCounters, graceful) {
+    auto counters = PerfCounters{};
+    auto a = counters.read();
+    auto b = counters.read();
+
+    ASSERT_LE(a.wallTime, b.wallTime);
+    for (auto c : {Counter::cycles, Counter::instructions, Counter::cacheMisses, Counter::branchMisses}) {
+        ASSERT_EQ(counters.isAvailable(c), static_cast<bool>(a[c])); // unavailable counters are empty
+    }
+}
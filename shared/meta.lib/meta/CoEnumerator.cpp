@@ -0,0 +1,7 @@
+#include "CoEnumerator.h"
+
+namespace meta {
+
+const EventCounter coEnumeratorResumes{"CoEnumerator.resume"};
+
+} // namespace meta
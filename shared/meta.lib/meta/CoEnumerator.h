@@ -1,11 +1,14 @@
 #pragma once
 
 #include "CoRoutine.h"
+#include "EventCounter.h"
 
 #include <iterator>
 
 namespace meta {
 
+extern const EventCounter coEnumeratorResumes;
+
 namespace std {
 using namespace ::std;
 using namespace ::std::experimental;
@@ -40,11 +43,17 @@ struct CoEnumerator {
 
     explicit operator bool() const { return handle && !handle.done(); }
     bool operator++(int) {
-        if (handle) handle.resume();
+        if (handle) {
+            coEnumeratorResumes.add();
+            handle.resume();
+        }
         return static_cast<bool>(*this);
     }
     auto operator++() -> This& {
-        if (handle) handle.resume();
+        if (handle) {
+            coEnumeratorResumes.add();
+            handle.resume();
+        }
         return *this;
     }
 
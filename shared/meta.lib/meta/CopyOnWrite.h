@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace meta {
+
+/// value semantics with shared immutable storage
+// copies only share the storage - modify() copies the value if it is shared
+// note: an empty instance does not allocate until it is modified
+template<class T>
+struct CopyOnWrite {
+    using This = CopyOnWrite;
+
+    CopyOnWrite() = default;
+    CopyOnWrite(T value)
+        : m_storage(std::make_shared<T>(std::move(value))) {}
+
+    auto get() const -> const T& { return m_storage ? *m_storage : empty(); }
+    auto operator*() const -> const T& { return get(); }
+    auto operator->() const -> const T* { return &get(); }
+
+    /// mutable access - detaches from other copies
+    // use_count() is a relaxed load - the fence orders our writes after the reads of copies on other threads
+    auto modify() -> T& {
+        if (!m_storage)
+            m_storage = std::make_shared<T>();
+        else if (m_storage.use_count() > 1)
+            m_storage = std::make_shared<T>(*m_storage);
+        else
+            std::atomic_thread_fence(std::memory_order_acquire);
+        return *m_storage;
+    }
+
+    /// true if both refer to the same storage (implies equal values)
+    bool isSame(const This& o) const { return m_storage == o.m_storage; }
+    bool isShared() const { return m_storage.use_count() > 1; }
+
+private:
+    static auto empty() -> const T& {
+        static const auto value = T{};
+        return value;
+    }
+
+private:
+    std::shared_ptr<T> m_storage{};
+};
+
+} // namespace meta
@@ -0,0 +1,38 @@
+#include "CopyOnWrite.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using Cow = meta::CopyOnWrite<std::vector<int>>;
+
+TEST(copyOnWrite, empty) {
+    auto a = Cow{};
+    auto b = a;
+
+    ASSERT_TRUE(a->empty());
+    ASSERT_TRUE(a.isSame(b));
+    ASSERT_FALSE(a.isShared()); // nothing allocated
+
+    a.modify().push_back(1);
+    ASSERT_EQ(a->size(), 1u);
+    ASSERT_TRUE(b->empty());
+}
+
+TEST(copyOnWrite, shared) {
+    const auto a = Cow{{1, 2, 3}};
+    auto b = a;
+
+    ASSERT_TRUE(a.isSame(b));
+    ASSERT_TRUE(a.isShared());
+    ASSERT_EQ(&a.get(), &b.get());
+
+    b.modify().push_back(4);
+    ASSERT_FALSE(a.isSame(b));
+    ASSERT_EQ(*a, (std::vector<int>{1, 2, 3}));
+    ASSERT_EQ(*b, (std::vector<int>{1, 2, 3, 4}));
+
+    auto* p = &b.get();
+    b.modify().push_back(5); // unique - no copy
+    ASSERT_EQ(p, &b.get());
+}
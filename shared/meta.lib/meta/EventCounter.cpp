@@ -0,0 +1,84 @@
+#include "EventCounter.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace meta {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex{};
+    std::vector<const EventCounter*> counters{};
+    std::vector<const details::ThreadEventCounts*> threads{};
+    std::array<uint64_t, details::maxEventCounters> finished{}; // counts of threads that ended
+};
+
+// constructed before the first thread counts, so it outlives all of them
+auto registry() -> Registry& {
+    static auto instance = Registry{};
+    return instance;
+}
+
+} // namespace
+
+auto EventCounter::registeredIndex() const noexcept -> size_t {
+    auto& r = registry();
+    auto lock = std::lock_guard{r.mutex};
+    auto index = m_index.load(std::memory_order_relaxed);
+    if (index != 0) return index;
+    if (r.counters.size() + 1 >= details::maxEventCounters) return 0;
+    r.counters.push_back(this);
+    index = r.counters.size();
+    m_index.store(index, std::memory_order_relaxed);
+    return index;
+}
+
+auto EventCounts::operator+=(const EventCounts& o) -> EventCounts& {
+    if (counts.size() < o.counts.size()) counts.resize(o.counts.size());
+    for (auto i = size_t{}; i < o.counts.size(); i++) counts[i] += o.counts[i];
+    return *this;
+}
+
+auto EventCounts::operator-(const EventCounts& o) const -> EventCounts {
+    auto result = *this;
+    for (auto i = size_t{}; i < std::min(counts.size(), o.counts.size()); i++) result.counts[i] -= o.counts[i];
+    return result;
+}
+
+auto readEventCounts() -> EventCounts {
+    auto& r = registry();
+    auto lock = std::lock_guard{r.mutex};
+    auto result = EventCounts{};
+    result.counts.resize(r.counters.size() + 1);
+    for (auto i = size_t{}; i < result.counts.size(); i++) {
+        result.counts[i] = r.finished[i];
+        for (const auto* thread : r.threads) result.counts[i] += thread->counts[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+auto usedEventCounters() -> std::vector<const EventCounter*> {
+    auto& r = registry();
+    auto lock = std::lock_guard{r.mutex};
+    return r.counters;
+}
+
+namespace details {
+
+ThreadEventCounts::ThreadEventCounts() {
+    auto& r = registry();
+    auto lock = std::lock_guard{r.mutex};
+    r.threads.push_back(this);
+}
+
+ThreadEventCounts::~ThreadEventCounts() {
+    auto& r = registry();
+    auto lock = std::lock_guard{r.mutex};
+    for (auto i = size_t{}; i < maxEventCounters; i++) r.finished[i] += counts[i].load(std::memory_order_relaxed);
+    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+}
+
+} // namespace details
+
+} // namespace meta
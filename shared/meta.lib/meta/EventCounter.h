@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace meta {
+
+/// counts an event on a hot path - always compiled in and cheap enough for inner loops
+// define counters at namespace scope, the constexpr constructor avoids any initialization order issues
+struct EventCounter {
+    constexpr explicit EventCounter(const char* name) noexcept
+        : m_name(name) {}
+
+    EventCounter(const EventCounter&) = delete;
+    EventCounter& operator=(const EventCounter&) = delete;
+
+    inline void add(uint64_t count = 1) const noexcept;
+
+    [[nodiscard]] auto name() const -> const char* { return m_name; }
+
+    /// position in EventCounts - 0 if the counter was never used
+    [[nodiscard]] auto index() const noexcept -> size_t { return m_index.load(std::memory_order_relaxed); }
+
+private:
+    auto registeredIndex() const noexcept -> size_t;
+
+    const char* m_name;
+    mutable std::atomic<size_t> m_index{};
+};
+
+/// sums of all counters at one point in time
+struct EventCounts {
+    std::vector<uint64_t> counts{}; // by EventCounter::index() - counts[0] collects counters beyond the limit
+
+    [[nodiscard]] auto operator[](const EventCounter& counter) const -> uint64_t {
+        auto index = counter.index();
+        return index != 0 && index < counts.size() ? counts[index] : 0;
+    }
+
+    auto operator+=(const EventCounts& o) -> EventCounts&;
+    [[nodiscard]] auto operator-(const EventCounts& o) const -> EventCounts;
+};
+
+/// sums up the counts of all threads
+// relaxed reads - counts of threads that are still running might be slightly behind
+[[nodiscard]] auto readEventCounts() -> EventCounts;
+
+/// counters that were used so far - the position + 1 matches their index
+[[nodiscard]] auto usedEventCounters() -> std::vector<const EventCounter*>;
+
+namespace details {
+
+constexpr auto maxEventCounters = size_t{64};
+
+/// counts of one thread - only this thread writes, so no atomic read-modify-write is needed
+struct ThreadEventCounts {
+    std::array<std::atomic<uint64_t>, maxEventCounters> counts{};
+
+    ThreadEventCounts();
+    ~ThreadEventCounts(); // keeps the counts when the thread ends
+
+    ThreadEventCounts(const ThreadEventCounts&) = delete;
+    ThreadEventCounts& operator=(const ThreadEventCounts&) = delete;
+};
+
+inline thread_local auto threadEventCounts = ThreadEventCounts{};
+
+} // namespace details
+
+void EventCounter::add(uint64_t count) const noexcept {
+    auto index = m_index.load(std::memory_order_relaxed);
+    if (index == 0) index = registeredIndex();
+    auto& slot = details::threadEventCounts.counts[index];
+    slot.store(slot.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+}
+
+} // namespace meta
@@ -0,0 +1,17 @@
+#pragma once
+#include "EventCounter.h"
+
+#include <iomanip>
+#include <ostream>
+
+namespace meta {
+
+inline auto operator<<(std::ostream& out, const EventCounts& counts) -> std::ostream& {
+    out << std::left << std::setw(24) << "event" << std::right << std::setw(16) << "count" << '\n';
+    for (const auto* counter : usedEventCounters()) {
+        out << std::left << std::setw(24) << counter->name() << std::right << std::setw(16) << counts[*counter] << '\n';
+    }
+    return out;
+}
+
+} // namespace meta
@@ -0,0 +1,27 @@
+#include "EventCounter.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+namespace {
+
+const auto testEvents = meta::EventCounter{"test.events"};
+const auto unusedEvents = meta::EventCounter{"test.unused"};
+
+} // namespace
+
+TEST(eventCounter, threads) {
+    auto before = meta::readEventCounts();
+    testEvents.add();
+    auto thread = std::thread([] {
+        for (auto i = 0; i < 10; i++) testEvents.add(2);
+    });
+    thread.join(); // counts of finished threads are kept
+
+    auto delta = meta::readEventCounts() - before;
+    EXPECT_EQ(delta[testEvents], 21u);
+    EXPECT_EQ(delta[unusedEvents], 0u);
+    EXPECT_EQ(unusedEvents.index(), 0u);
+    EXPECT_NE(testEvents.index(), 0u);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "TypeTraits.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace meta {
+
+/// combines a hash value into a seed
+// same mixing as boost::hash_combine (golden ratio spreads the bits)
+constexpr auto hashCombine(size_t seed, size_t value) -> size_t {
+    return seed ^ (value + 0x9e3779b9 + (seed << 6u) + (seed >> 2u));
+}
+
+namespace details {
+
+template<class T, class = size_t>
+constexpr bool has_hash_member = false;
+template<class T>
+constexpr bool has_hash_member<T, decltype(declVal<const T&>().hash())> = true;
+
+template<class T, class = size_t>
+constexpr bool has_std_hash = false;
+template<class T>
+constexpr bool has_std_hash<T, decltype(std::hash<T>{}(declVal<const T&>()))> = true;
+
+} // namespace details
+
+/// true if hashOf() is able to compute a hash for T
+template<class T>
+constexpr bool is_hashable = details::has_hash_member<T> || details::has_std_hash<T>;
+
+/// structural hash of a value
+// prefers a `hash()` member, uses std::hash otherwise
+template<class T>
+auto hashOf(const T& v) -> size_t {
+    static_assert(is_hashable<T>, "type is not hashable");
+    if constexpr (details::has_hash_member<T>) {
+        return v.hash();
+    }
+    else {
+        return std::hash<T>{}(v);
+    }
+}
+
+/// hash of a range of values (order dependent)
+template<class C>
+auto hashRange(const C& c, size_t seed = {}) -> size_t {
+    for (const auto& e : c) seed = hashCombine(seed, hashOf(e));
+    return seed;
+}
+
+} // namespace meta
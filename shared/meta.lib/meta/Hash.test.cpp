@@ -0,0 +1,36 @@
+#include "Hash.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+struct WithMember {
+    int v{};
+    auto hash() const -> size_t { return static_cast<size_t>(v) * 7; }
+};
+struct NotHashable {};
+
+} // namespace
+
+TEST(hash, detection) {
+    static_assert(meta::is_hashable<int>);
+    static_assert(meta::is_hashable<const char*>);
+    static_assert(meta::is_hashable<WithMember>);
+    static_assert(!meta::is_hashable<NotHashable>);
+    static_assert(!meta::is_hashable<std::vector<int>>);
+}
+
+TEST(hash, member) {
+    ASSERT_EQ(meta::hashOf(WithMember{3}), 21u);
+    ASSERT_EQ(meta::hashOf(3), std::hash<int>{}(3));
+}
+
+TEST(hash, range) {
+    auto a = std::vector<int>{1, 2, 3};
+    auto b = std::vector<int>{3, 2, 1};
+
+    ASSERT_EQ(meta::hashRange(a), meta::hashRange(std::vector<int>{1, 2, 3}));
+    ASSERT_NE(meta::hashRange(a), meta::hashRange(b)); // order matters
+    ASSERT_NE(meta::hashCombine(0, 1), meta::hashCombine(1, 0));
+}
@@ -274,12 +274,12 @@ struct CodePoint {
             out.push_back(0xC0 | ((v >> 6) & 0x1F));
             out.push_back(0x80 | ((v >> 0) & 0x3F));
         }
-        else if (v < 0xFFFF) {
+        else if (v <= 0xFFFF) {
             out.push_back(0xE0 | ((v >> 12) & 0xF));
             out.push_back(0x80 | ((v >> 6) & 0x3F));
             out.push_back(0x80 | ((v >> 0) & 0x3F));
         }
-        else if (v < 0x10'FFFF) {
+        else if (v <= 0x10'FFFF) {
             out.push_back(0xF0 | ((v >> 18) & 0x7));
             out.push_back(0x80 | ((v >> 12) & 0x3F));
             out.push_back(0x80 | ((v >> 6) & 0x3F));
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 TEST(codepoint, decimal) {
     constexpr auto d = strings::Decimal{};
 
@@ -53,3 +55,16 @@ TEST(codepoint, ostream) {
     ss << cp;
     ASSERT_EQ(ss.str(), "0x2713");
 }
+
+TEST(codepoint, utf8EncodeMatchesByteCount) {
+    struct Bytes {
+        std::vector<uint8_t> v{};
+        void push_back(uint8_t c) { v.push_back(c); }
+    };
+    for (auto n : {0x7Fu, 0x80u, 0x7FFu, 0x800u, 0xFFFFu, 0x1'0000u, 0x10'FFFFu}) {
+        auto cp = strings::CodePoint{n};
+        auto bytes = Bytes{};
+        cp.utf8_encode(bytes);
+        EXPECT_EQ(bytes.v.size(), cp.utf8_byteCount().v) << cp;
+    }
+}
@@ -1,3 +1,86 @@
 #include "Rope.h"
 
-// empty
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace strings {
+
+auto Rope::slice(Counter start, Counter count) const -> Rope {
+    auto result = Rope{};
+    const auto begin = start.v;
+    constexpr auto maxEnd = std::numeric_limits<size_t>::max();
+    const auto end = count.v > maxEnd - begin ? maxEnd : begin + count.v; // saturates
+    auto position = size_t{};
+    auto isContinuation = [](Char c) { return (static_cast<uint8_t>(c) & 0xC0u) == 0x80u; };
+    // whole code points of a piece that lie inside the slice - empty if there are none
+    auto overlap = [&](View bytes) {
+        auto size = static_cast<size_t>(bytes.byteCount().v);
+        auto first = std::clamp(begin, position, position + size) - position;
+        auto last = std::clamp(end, position, position + size) - position;
+        position += size;
+        while (first < last && isContinuation(bytes.begin()[first])) first++;
+        while (last > first && last < size && isContinuation(bytes.begin()[last])) last--;
+        return View{bytes.begin() + first, bytes.begin() + last};
+    };
+    for (const auto& e : m) {
+        if (position >= end) break;
+        e.visit(
+            [&](CodePoint cp) {
+                auto encoded = Utf8Bytes{};
+                cp.utf8_encode(encoded);
+                auto part = overlap(View{encoded.data, encoded.data + encoded.size});
+                if (part.byteCount().v == encoded.size) result += cp;
+            },
+            [&](const String& s) {
+                auto part = overlap(View{s});
+                if (part.byteCount() == s.byteCount())
+                    result += String{s};
+                else if (!part.isEmpty())
+                    result += String{part.begin(), part.end()};
+            },
+            [&](const View& v) { result += overlap(v); });
+    }
+    return result;
+}
+
+bool Rope::operator==(const This& o) const {
+    if (byteCount() != o.byteCount()) return false;
+    auto other = o.m.begin();
+    auto encoded = Utf8Bytes{};
+    auto pending = View{}; // unmatched bytes of the current piece of o
+    auto equal = true;
+    forEachPiece([&](View piece) {
+        while (equal && !piece.isEmpty()) {
+            while (pending.isEmpty()) { // byte counts are equal - o has pieces left
+                pending = other->visit(
+                    [&](CodePoint cp) {
+                        encoded = Utf8Bytes{};
+                        cp.utf8_encode(encoded);
+                        return View{encoded.data, encoded.data + encoded.size};
+                    },
+                    [](const String& s) { return View{s}; },
+                    [](const View& v) { return v; });
+                ++other;
+            }
+            auto n = std::min(piece.size(), pending.size());
+            equal = std::equal(piece.begin(), piece.begin() + n, pending.begin());
+            piece = View{piece.begin() + n, piece.end()};
+            pending = View{pending.begin() + n, pending.end()};
+        }
+    });
+    return equal;
+}
+
+bool Rope::operator==(const View& v) const {
+    if (byteCount() != v.byteCount()) return false;
+    auto pending = v.begin();
+    auto equal = true;
+    forEachPiece([&](View piece) {
+        equal = equal && std::equal(piece.begin(), piece.end(), pending);
+        pending += piece.size();
+    });
+    return equal;
+}
+
+} // namespace strings
@@ -21,6 +21,12 @@ struct Rope {
 private:
     std::vector<Data> m{};
 
+    struct Utf8Bytes { // target of CodePoint::utf8_encode without allocation
+        Char data[4]{};
+        size_t size{};
+        void push_back(uint32_t byte) { data[size++] = static_cast<Char>(byte); }
+    };
+
 public:
     Rope() = default; // valid empty rope
 
@@ -47,11 +53,33 @@ public:
         m.emplace_back(v);
         return *this;
     }
-    This& operator+=(Rope& r) {
+    This& operator+=(const Rope& r) {
         m.insert(m.end(), r.m.begin(), r.m.end());
         return *this;
     }
 
+    /// bytes [start, start + count) - clamped to the rope and shrunk to whole code points
+    // views are narrowed, strings are copied
+    [[nodiscard]] auto slice(Counter start, Counter count) const -> Rope;
+
+    /// calls f(View) for every piece in order - without joining them
+    template<class F>
+    void forEachPiece(F&& f) const {
+        for (const auto& e : m) {
+            e.visit(
+                [&](CodePoint cp) {
+                    auto encoded = Utf8Bytes{};
+                    cp.utf8_encode(encoded);
+                    f(View{encoded.data, encoded.data + encoded.size});
+                },
+                [&](const String& s) { f(View{s}); },
+                [&](const View& v) { f(v); });
+        }
+    }
+
+    /// number of pieces the rope has allocated space for (memory statistics)
+    auto pieceCapacity() const -> size_t { return m.capacity(); }
+
     Counter byteCount() const {
         return meta::accumulate(m, Counter{0}, [](Counter c, const Data& e) {
             return e.visit(
@@ -74,20 +102,22 @@ public:
         return String{std::move(result)};
     }
 
-    bool operator==(const This& o) const {
-        // TODO(arBmind): eliminate temporary allocations (when used outside of tests)
-        auto tmp = static_cast<String>(*this);
-        auto tmp2 = static_cast<String>(o);
-        return tmp == tmp2;
-    }
+    /// content comparison - pieces are compared in place
+    bool operator==(const This& o) const;
     bool operator!=(const This& o) const { return !(*this == o); }
 
-    bool operator==(const View& v) const {
-        // TODO(arBmind): eliminate temporary allocation (when used outside of tests)
-        auto tmp = static_cast<String>(*this);
-        return v.isContentEqual(View(tmp));
-    }
+    bool operator==(const View& v) const;
     bool operator!=(const View& o) const { return !(*this == o); }
+
+    /// hash of the content (independent of the pieces)
+    // FNV-1a runs byte by byte, so it continues seamlessly across piece boundaries
+    auto hash() const -> size_t {
+        auto h = uint64_t{0xcbf29ce484222325};
+        forEachPiece([&](View v) {
+            for (auto c : v) h = (h ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+        });
+        return static_cast<size_t>(h);
+    }
 };
 
 inline String to_string(const Rope& r) { return static_cast<String>(r); }
@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <string>
+#include <vector>
+
 TEST(rope, basic) {
     auto r = strings::Rope{};
 
@@ -21,3 +25,51 @@ TEST(rope, basic) {
 
     // EXPECT_EQ(r, strings::View{"fowl"}); // trigger failing assert output
 }
+
+TEST(rope, hashIgnoresPieces) {
+    auto pieces = strings::Rope{strings::View{"fo"}};
+    pieces += strings::CodePoint{0xE4};
+    pieces += strings::String{"bar"};
+    auto whole = strings::Rope{strings::View{"fo\xC3\xA4" "bar"}};
+
+    EXPECT_EQ(pieces, whole);
+    EXPECT_EQ(pieces.hash(), whole.hash());
+    EXPECT_NE(pieces.hash(), strings::Rope{strings::View{"fo\xC3\xA4" "baz"}}.hash());
+    EXPECT_NE(strings::Rope{}.hash(), strings::Rope{strings::View{"a"}}.hash());
+}
+
+TEST(rope, slice) {
+    auto r = strings::Rope{strings::View{"foo"}};
+    r += strings::String{"bar"};
+    r += strings::CodePoint{0xE4}; // ä - two bytes
+    r += strings::View{"baz"};
+
+    EXPECT_EQ(r.slice({0}, {3}), strings::View{"foo"});
+    EXPECT_EQ(r.slice({2}, {3}), strings::View{"oba"});
+    EXPECT_EQ(r.slice({5}, {6}), strings::View{"r\xC3\xA4" "baz"});
+    EXPECT_EQ(r.slice({9}, {10}), strings::View{"az"});
+    EXPECT_TRUE(r.slice({20}, {1}).isEmpty());
+    EXPECT_EQ(r.slice({9}, {std::numeric_limits<size_t>::max()}), strings::View{"az"}); // end saturates
+}
+
+TEST(rope, sliceKeepsWholeCodePoints) {
+    auto r = strings::Rope{strings::View{"a\xC3\xA4"}}; // aä
+    r += strings::String{"\xC3\xB6"}; // ö
+    r += strings::CodePoint{0xFC}; // ü
+
+    EXPECT_EQ(r.slice({0}, {2}), strings::View{"a"});
+    EXPECT_EQ(r.slice({2}, {3}), strings::View{"\xC3\xB6"});
+    EXPECT_EQ(r.slice({1}, {4}), strings::View{"\xC3\xA4\xC3\xB6"});
+    EXPECT_EQ(r.slice({4}, {3}), strings::View{"\xC3\xBC"});
+    EXPECT_TRUE(r.slice({6}, {1}).isEmpty());
+}
+
+TEST(rope, forEachPiece) {
+    auto r = strings::Rope{strings::View{"foo"}};
+    r += strings::CodePoint{'-'};
+    r += strings::String{"bar"};
+
+    auto pieces = std::vector<std::string>{};
+    r.forEachPiece([&](strings::View v) { pieces.emplace_back(v.begin(), v.end()); });
+    EXPECT_EQ(pieces, (std::vector<std::string>{"foo", "-", "bar"}));
+}
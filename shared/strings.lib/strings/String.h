@@ -5,6 +5,7 @@
 
 #include <initializer_list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace strings {
@@ -44,6 +45,7 @@ public:
 
     auto data() const -> const Char* { return m.data(); }
     auto byteCount() const -> Counter { return {m.size()}; }
+    auto byteCapacity() const -> Counter { return {m.capacity()}; } ///< allocated bytes
     bool isEmpty() const { return m.empty(); }
 
     auto begin() const -> const Char* { return m.data(); }
@@ -51,6 +53,8 @@ public:
 
     bool operator==(const This& o) const { return m == o.m; }
     bool operator<(const This& o) const { return m < o.m; }
+
+    auto hash() const -> size_t { return std::hash<std::string_view>{}({m.data(), m.size()}); }
 };
 using OptionalString = meta::Optional<meta::DefaultPacked<String>>;
 
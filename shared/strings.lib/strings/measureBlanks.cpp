@@ -0,0 +1,65 @@
+#include "measureBlanks.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define STRINGS_BLANKS_SSE2
+#endif
+
+namespace strings {
+
+namespace {
+
+void scalarBlanks(const char* p, const char* e, char first, BlankRun& run) {
+    for (; p != e; p++) {
+        auto c = *p;
+        if (c != ' ' && c != '\t') return;
+        if (!run.isMixed() && c == first) run.mixedOffset++;
+        run.count++;
+    }
+}
+
+#ifdef STRINGS_BLANKS_SSE2
+auto firstBit(unsigned mask) -> size_t {
+#    if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index{};
+    _BitScanForward(&index, mask);
+    return index;
+#    else
+    return static_cast<size_t>(__builtin_ctz(mask));
+#    endif
+}
+#endif
+
+} // namespace
+
+auto measureBlanks(View view) -> BlankRun {
+    auto run = BlankRun{};
+    auto p = view.begin();
+    auto e = view.end();
+    if (p == e) return run;
+    auto first = *p;
+
+#ifdef STRINGS_BLANKS_SSE2
+    const auto spaces = _mm_set1_epi8(' ');
+    const auto tabs = _mm_set1_epi8('\t');
+    const auto others = first == ' ' ? tabs : spaces;
+    for (; e - p >= 16; p += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto isSpace = _mm_cmpeq_epi8(chunk, spaces);
+        auto isTab = _mm_cmpeq_epi8(chunk, tabs);
+        auto blankMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(isSpace, isTab)));
+        auto otherMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, others)));
+        auto blanks = blankMask == 0xFFFFu ? size_t{16} : firstBit(~blankMask);
+        if (!run.isMixed()) {
+            auto validOther = otherMask & ((1u << blanks) - 1u);
+            run.mixedOffset = run.count + (validOther != 0 ? firstBit(validOther) : blanks);
+        }
+        run.count += blanks;
+        if (blanks != 16) return run;
+    }
+#endif
+    scalarBlanks(p, e, first, run);
+    return run;
+}
+
+} // namespace strings
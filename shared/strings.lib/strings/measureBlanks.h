@@ -0,0 +1,20 @@
+#pragma once
+#include "View.h"
+
+#include <cstddef>
+
+namespace strings {
+
+/// leading run of spaces and tabs in a view
+struct BlankRun {
+    size_t count{}; ///< bytes in the run
+    size_t mixedOffset{}; ///< first byte in the run that differs from the first one (count if none)
+
+    constexpr bool isMixed() const { return mixedOffset < count; }
+};
+
+/// measures the leading spaces and tabs of view
+// works on the raw bytes - 16 bytes at a time where SSE2 is available
+auto measureBlanks(View view) -> BlankRun;
+
+} // namespace strings
@@ -0,0 +1,43 @@
+#include "measureBlanks.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace strings;
+
+namespace {
+
+auto measure(const std::string& s) { return measureBlanks(View{s}); }
+
+} // namespace
+
+TEST(measureBlanks, empty) {
+    auto run = measure("");
+    EXPECT_EQ(run.count, 0u);
+    EXPECT_FALSE(run.isMixed());
+
+    EXPECT_EQ(measure("a  ").count, 0u);
+}
+
+TEST(measureBlanks, short) {
+    auto run = measure("  \tx");
+    EXPECT_EQ(run.count, 3u);
+    EXPECT_EQ(run.mixedOffset, 2u);
+
+    run = measure("\t\t");
+    EXPECT_EQ(run.count, 2u);
+    EXPECT_FALSE(run.isMixed());
+}
+
+// runs crossing the 16 byte chunks have to match the scalar result
+TEST(measureBlanks, long) {
+    for (auto length = 1u; length < 50; length++) {
+        for (auto mixed = 1u; mixed <= length; mixed++) {
+            auto s = std::string(mixed, ' ') + std::string(length - mixed, '\t') + "x" + std::string(20, ' ');
+            auto run = measure(s);
+            EXPECT_EQ(run.count, length) << length << ' ' << mixed;
+            EXPECT_EQ(run.mixedOffset, mixed) << length << ' ' << mixed;
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <meta/Hash.h>
 #include <meta/Variant.h>
 
 #include <strings/CodePoint.h>
@@ -18,6 +19,14 @@ struct InputPositionData {
 
     constexpr bool operator==(const This& o) const { return input == o.input && position == o.position; }
     constexpr bool operator!=(const This& o) const { return !(*this == o); }
+
+    /// note: views are equal if they point to the same range, so we hash the range
+    auto hash() const -> size_t {
+        auto h = meta::hashOf(input.begin());
+        h = meta::hashCombine(h, meta::hashOf(input.end()));
+        h = meta::hashCombine(h, position.line.v);
+        return meta::hashCombine(h, position.column.v);
+    }
 };
 
 template<class...>
@@ -34,9 +43,24 @@ struct CodePointPosition : InputPositionData {
     constexpr bool operator!=(const This& o) const { return !(*this == o); }
 };
 
+/// run of spaces and tabs directly after a newline
+// measured on the source bytes - only produced by decodePosition(View, Config)
+struct IndentationPosition : InputPositionData {
+    using This = IndentationPosition;
+    Position endPosition{};
+    size_t mixedOffset{}; ///< first byte that differs from the first one (input size if none)
+    Position mixedPosition{};
+
+    constexpr bool operator==(const This& o) const {
+        return input == o.input && position == o.position && endPosition == o.endPosition &&
+            mixedOffset == o.mixedOffset && mixedPosition == o.mixedPosition;
+    }
+    constexpr bool operator!=(const This& o) const { return !(*this == o); }
+};
+
 using NewlinePosition = InputPosition<struct NewlinePositionTag>;
 using DecodedErrorPosition = InputPosition<struct DecodedErrorPositionTag>;
 
-using DecodedPosition = meta::Variant<CodePointPosition, NewlinePosition, DecodedErrorPosition>;
+using DecodedPosition = meta::Variant<CodePointPosition, NewlinePosition, DecodedErrorPosition, IndentationPosition>;
 
 } // namespace text
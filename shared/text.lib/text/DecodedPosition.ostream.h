@@ -12,6 +12,7 @@ namespace meta {
 constexpr auto nameOf(Type<text::CodePointPosition>) { return "CP"; }
 constexpr auto nameOf(Type<text::NewlinePosition>) { return "Newline"; }
 constexpr auto nameOf(Type<text::DecodedErrorPosition>) { return "Error"; }
+constexpr auto nameOf(Type<text::IndentationPosition>) { return "Indentation"; }
 
 } // namespace meta
 
@@ -23,6 +24,11 @@ auto operator<<(::std::basic_ostream<Char, CharTraits>& out, CodePointPosition c
                << " = cp: " << cpp.codePoint << cpp.position;
 }
 
+template<typename Char, typename CharTraits>
+auto operator<<(::std::basic_ostream<Char, CharTraits>& out, IndentationPosition ip) -> decltype(out) {
+    return out << ": " << std::hex << ip.input << ip.position << " - " << ip.endPosition;
+}
+
 template<typename Char, typename CharTraits, class... Tags>
 auto operator<<(::std::basic_ostream<Char, CharTraits>& out, InputPosition<Tags...> ip) -> decltype(out) {
     return out << ": " << std::hex << ip.input << ip.position;
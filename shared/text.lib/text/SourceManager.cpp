@@ -0,0 +1,86 @@
+#include "SourceManager.h"
+
+#include "strings/utf8Decode.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace text {
+
+namespace {
+
+auto indexLineStarts(strings::View content, const Config& config) -> std::vector<uint32_t> {
+    auto starts = std::vector<uint32_t>{0};
+    for (auto dp : decodePosition(content, config)) {
+        dp.visitSome([&](const NewlinePosition& nl) {
+            starts.push_back(static_cast<uint32_t>(nl.input.end() - content.begin()));
+        });
+    }
+    return starts;
+}
+
+} // namespace
+
+auto SourceManager::add(File file) -> const File& {
+    auto size = file.content.byteCount().v;
+    if (size >= m_capacity - m_next) throw std::length_error("source offset space exhausted");
+    auto base = m_next;
+    m_next += static_cast<uint32_t>(size) + 1; // + 1 for the end of file location
+
+    auto entry = std::make_shared<Entry>(Entry{std::move(file), base});
+    entry->lineStarts = indexLineStarts(strings::View{entry->file.content}, m_config);
+    auto less = [](const Entry* a, const char* p) { return std::less<>{}(a->file.content.begin(), p); };
+    auto at = std::lower_bound(m_byAddress.begin(), m_byAddress.end(), entry->file.content.begin(), less);
+    m_byAddress.insert(at, entry.get());
+    m_entries.push_back(std::move(entry));
+    return m_entries.back()->file;
+}
+
+auto SourceManager::locOf(strings::View view) const -> SourceLoc {
+    auto p = view.begin();
+    if (p == nullptr) return {};
+    // last file that starts at or before p
+    auto greater = [](const char* p, const Entry* e) { return std::less<>{}(p, e->file.content.begin()); };
+    auto it = std::upper_bound(m_byAddress.begin(), m_byAddress.end(), p, greater);
+    if (it == m_byAddress.begin()) return {};
+    const auto& entry = **(it - 1);
+    const auto& content = entry.file.content;
+    if (std::less<>{}(content.end(), p)) return {};
+    return SourceLoc{entry.base + static_cast<uint32_t>(p - content.begin())};
+}
+
+auto SourceManager::entryOf(SourceLoc loc) const -> const Entry* {
+    if (!loc.isValid() || loc.v >= m_next) return nullptr;
+    auto it = std::upper_bound(
+        m_entries.begin(), m_entries.end(), loc.v, [](uint32_t v, const EntryPtr& e) { return v < e->base; });
+    return (it - 1)->get();
+}
+
+auto SourceManager::fileOf(SourceLoc loc) const -> const File* {
+    auto entry = entryOf(loc);
+    return entry ? &entry->file : nullptr;
+}
+
+auto SourceManager::resolve(SourceLoc loc) const -> ResolvedLoc {
+    auto entry = entryOf(loc);
+    if (!entry) return {};
+    auto offset = loc.v - entry->base;
+    const auto& starts = entry->lineStarts;
+    auto lineIt = std::upper_bound(starts.begin(), starts.end(), offset) - 1;
+
+    auto result = ResolvedLoc{&entry->file};
+    result.position.line = Line{static_cast<uint32_t>(lineIt - starts.begin()) + 1};
+
+    // columns depend on tab stops and code points, so decode the line up to the location
+    auto begin = entry->file.content.begin();
+    auto prefix = strings::View{begin + *lineIt, begin + offset};
+    for (auto dp : decodePosition(prefix, m_config)) {
+        dp.visitSome(
+            [&](const CodePointPosition& cpp) { result.position.column = cpp.endPosition.column; },
+            [&](const IndentationPosition& ip) { result.position.column = ip.endPosition.column; });
+    }
+    return result;
+}
+
+} // namespace text
@@ -0,0 +1,80 @@
+#pragma once
+#include "File.h"
+#include "Position.h"
+#include "decodePosition.h"
+
+#include "strings/View.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace text {
+
+/// compact location in the offset space of a SourceManager
+// 0 is invalid - each file occupies [base, base + size], the end of a file is a valid location
+// note: tokens, nodes and diagnostics keep their views and positions - the scanner and the parser run on plain views
+// without a manager, locOf maps a view to its location where one has to be stored or resolved
+struct SourceLoc {
+    using This = SourceLoc;
+    uint32_t v{};
+
+    constexpr bool isValid() const { return v != 0; }
+
+    constexpr bool operator==(const This& o) const { return v == o.v; }
+    constexpr bool operator!=(const This& o) const { return v != o.v; }
+    constexpr bool operator<(const This& o) const { return v < o.v; }
+};
+static_assert(sizeof(SourceLoc) == 4);
+
+/// file and position of a SourceLoc
+struct ResolvedLoc {
+    const File* file{};
+    Position position{};
+};
+
+/// owns all loaded files and assigns each a range in one global 32 bit offset space
+// files are immutable once added - copies of the manager share them (the text stays valid while any copy lives)
+// add is not thread safe, all const methods are
+struct SourceManager {
+    static constexpr auto maxCapacity = std::numeric_limits<uint32_t>::max();
+
+    /// capacity limits the offset space (only tests use a smaller one)
+    explicit SourceManager(Config config = {}, uint32_t capacity = maxCapacity)
+        : m_config(config)
+        , m_capacity(capacity) {}
+
+    /// takes ownership - file content stays at a stable address
+    // indexes the line starts of the file, so resolving never modifies the manager
+    // throws std::length_error if the file does not fit into the remaining offset space
+    auto add(File file) -> const File&;
+
+    [[nodiscard]] auto fileCount() const -> size_t { return m_entries.size(); }
+
+    /// location of the first byte of view (invalid if view is not part of a file)
+    [[nodiscard]] auto locOf(strings::View view) const -> SourceLoc;
+
+    /// file that contains loc (nullptr if invalid)
+    [[nodiscard]] auto fileOf(SourceLoc loc) const -> const File*;
+
+    /// file, line and column of loc
+    [[nodiscard]] auto resolve(SourceLoc loc) const -> ResolvedLoc;
+
+private:
+    struct Entry {
+        File file{};
+        uint32_t base{};
+        std::vector<uint32_t> lineStarts{}; // byte offsets
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+    [[nodiscard]] auto entryOf(SourceLoc loc) const -> const Entry*;
+
+    Config m_config{};
+    uint32_t m_capacity{};
+    std::vector<EntryPtr> m_entries{}; // ordered by base
+    std::vector<const Entry*> m_byAddress{}; // ordered by the address of the content - for locOf
+    uint32_t m_next{1};
+};
+
+} // namespace text
@@ -0,0 +1,79 @@
+#include "SourceManager.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace text;
+
+TEST(sourceManager, locations) {
+    auto manager = SourceManager{Config{Column{4}}};
+    const auto& a = manager.add(File{strings::String{"a.rebuild"}, strings::String{"first\n\tsecond"}});
+    const auto& b = manager.add(File{strings::String{"b.rebuild"}, strings::String{"x"}});
+    ASSERT_EQ(manager.fileCount(), 2u);
+
+    auto aSecond = manager.locOf(strings::View{a.content.begin() + 7, a.content.end()});
+    auto bStart = manager.locOf(strings::View{b.content});
+    ASSERT_TRUE(aSecond.isValid());
+    ASSERT_TRUE(bStart.isValid());
+    EXPECT_LT(aSecond, bStart);
+
+    EXPECT_EQ(manager.fileOf(aSecond), &a);
+    EXPECT_EQ(manager.fileOf(bStart), &b);
+
+    auto resolved = manager.resolve(aSecond);
+    EXPECT_EQ(resolved.file, &a);
+    EXPECT_EQ(resolved.position, (Position{Line{2}, Column{5}}));
+
+    EXPECT_EQ(manager.resolve(bStart).position, (Position{Line{1}, Column{1}}));
+}
+
+TEST(sourceManager, invalid) {
+    auto manager = SourceManager{};
+    manager.add(File{strings::String{"a"}, strings::String{"abc"}});
+
+    auto other = strings::String{"abc"};
+    EXPECT_FALSE(manager.locOf(strings::View{other}).isValid());
+    EXPECT_EQ(manager.fileOf(SourceLoc{}), nullptr);
+    EXPECT_EQ(manager.resolve(SourceLoc{1000}).file, nullptr);
+}
+
+// locations are found by address, independent of the order the files were added in
+TEST(sourceManager, manyFiles) {
+    auto manager = SourceManager{};
+    auto files = std::vector<const File*>{};
+    for (auto i = 0; i < 20; i++) files.push_back(&manager.add(File{strings::String{"f"}, strings::String{"a\nbc"}}));
+
+    for (const auto* file : files) {
+        auto loc = manager.locOf(strings::View{file->content.begin() + 3, file->content.end()});
+        EXPECT_EQ(manager.fileOf(loc), file);
+        EXPECT_EQ(manager.resolve(loc).position, (Position{Line{2}, Column{2}}));
+    }
+}
+
+// copies share the files - the text outlives the original manager
+TEST(sourceManager, copiesShareFiles) {
+    auto original = std::make_unique<SourceManager>();
+    const auto& file = original->add(File{strings::String{"a"}, strings::String{"abc"}});
+    auto loc = original->locOf(strings::View{file.content});
+
+    const auto copy = *original;
+    original.reset();
+
+    EXPECT_EQ(copy.fileOf(loc), &file);
+    EXPECT_TRUE(strings::View{copy.fileOf(loc)->content}.isContentEqual(strings::View{"abc"}));
+}
+
+// running out of offset space is an error in every build type
+TEST(sourceManager, capacityExhausted) {
+    auto manager = SourceManager{Config{}, 10};
+    manager.add(File{strings::String{"a"}, strings::String{"abcd"}}); // occupies [1, 5]
+
+    EXPECT_THROW(manager.add(File{strings::String{"b"}, strings::String{"abcd"}}), std::length_error);
+    EXPECT_EQ(manager.fileCount(), 1u);
+
+    manager.add(File{strings::String{"c"}, strings::String{"abc"}}); // occupies [6, 9]
+    EXPECT_EQ(manager.fileCount(), 2u);
+}
@@ -2,28 +2,31 @@
 #include <meta/CoEnumerator.h>
 
 #include <strings/Decoded.h>
+#include <strings/measureBlanks.h>
+#include <strings/utf8Decode.h>
 
 #include "DecodedPosition.h"
 
+#include <algorithm>
+
 namespace text {
 
 struct Config {
     Column tabStops{}; ///< columns per tabstop
 };
 
-inline auto decodePosition( //
-    meta::CoEnumerator<strings::Decoded> in,
-    Config config) -> meta::CoEnumerator<DecodedPosition> {
+namespace details {
 
-    using strings::DecodedCodePoint;
+/// tracks the position of decoded elements - shared by both decodePosition variants
+struct PositionDecoder {
+    Config config{};
+    Position position{};
 
-    auto isDual = [](auto cp) { return cp == '\n' || cp == '\r'; };
-    Position position;
-    ++in;
-    while (in) {
-        auto c = *in;
-        ++in;
-        co_yield c.visit(
+    auto operator()(strings::Decoded c, meta::CoEnumerator<strings::Decoded>& in) -> DecodedPosition {
+        using strings::DecodedCodePoint;
+
+        auto isDual = [](auto cp) { return cp == '\n' || cp == '\r'; };
+        return c.visit(
             [&](DecodedCodePoint dcp) -> DecodedPosition {
                 auto cp = dcp.cp;
                 if (cp.isLineSeparator()) {
@@ -66,5 +69,75 @@ inline auto decodePosition( //
                 return DecodedErrorPosition{ie.input, position};
             });
     }
+
+    /// positions for a run of spaces and tabs (see strings::measureBlanks)
+    auto indentation(View blanks, size_t mixedOffset) -> IndentationPosition {
+        auto r = IndentationPosition{{blanks, position}};
+        r.mixedOffset = mixedOffset;
+        advanceSame(*blanks.begin(), mixedOffset);
+        r.mixedPosition = position;
+        for (auto it = blanks.begin() + mixedOffset; it != blanks.end(); it++) advanceSame(*it, 1);
+        r.endPosition = position;
+        return r;
+    }
+
+private:
+    // the leading part of a run is uniform, so the column is computed arithmetically
+    void advanceSame(char blank, size_t count) {
+        if (count == 0) return;
+        if (blank == '\t') {
+            position.nextTabstop(config.tabStops);
+            position.column.v += static_cast<uint32_t>(count - 1) * config.tabStops.v;
+            return;
+        }
+        position.column.v += static_cast<uint32_t>(count);
+    }
+};
+
+} // namespace details
+
+inline auto decodePosition( //
+    meta::CoEnumerator<strings::Decoded> in,
+    Config config) -> meta::CoEnumerator<DecodedPosition> {
+
+    auto decoder = details::PositionDecoder{config};
+    ++in;
+    while (in) {
+        auto c = *in;
+        ++in;
+        co_yield decoder(c, in);
+    }
+}
+
+/// decodes source with positions
+// indentation after each newline is measured directly on the source bytes and yielded as one IndentationPosition
+inline auto decodePosition(strings::View source, Config config) -> meta::CoEnumerator<DecodedPosition> {
+    auto decoder = details::PositionDecoder{config};
+    auto rest = source;
+    while (!rest.isEmpty()) {
+        auto in = strings::utf8Decode(rest);
+        rest = View{source.end(), source.end()};
+        ++in;
+        while (in) {
+            auto c = *in;
+            ++in;
+            auto decoded = decoder(c, in);
+            auto isNewline = decoded.holds<NewlinePosition>();
+            auto after = isNewline ? View{decoded.get<NewlinePosition>().input.end(), source.end()} : View{};
+            co_yield decoded;
+            if (!isNewline) continue;
+
+            auto run = strings::measureBlanks(after);
+            auto count = run.count;
+            // combining marks belong to the last blank - leave it to the slow path
+            if (count > 0 && count < after.size() && static_cast<uint8_t>(after.begin()[count]) >= 0x80) count--;
+            if (count == 0) continue;
+
+            co_yield decoder.indentation(View{after.begin(), after.begin() + count}, std::min(run.mixedOffset, count));
+            rest = View{after.begin() + count, source.end()};
+            break; // restart decoding behind the indentation
+        }
+    }
 }
+
 } // namespace text
@@ -45,3 +45,56 @@ TEST(decodePosition, simple) {
 
     ASSERT_FALSE(++e);
 }
+
+TEST(decodePosition, sourceIndentation) {
+    using CP = strings::CodePoint;
+    using DP = text::DecodedPosition;
+    using CPP = text::CodePointPosition;
+    using NP = text::NewlinePosition;
+    using IP = text::IndentationPosition;
+    using P = text::Position;
+    using Col = text::Column;
+    using Line = text::Line;
+
+    auto source = strings::View{"\n  \t\ta"};
+    auto e = text::decodePosition(source, text::Config{Col{4}});
+
+    ASSERT_TRUE(e);
+    ASSERT_TRUE(++e);
+    EXPECT_EQ(*e, (DP{NP{source.firstBytes<1>(), P{Line{1}, Col{1}}}}));
+
+    ASSERT_TRUE(++e);
+    auto ip = IP{{source.skipBytes<1>().firstBytes<4>(), P{Line{2}, Col{1}}}};
+    ip.endPosition = P{Line{2}, Col{9}};
+    ip.mixedOffset = 2;
+    ip.mixedPosition = P{Line{2}, Col{3}};
+    EXPECT_EQ(*e, DP{ip});
+
+    ASSERT_TRUE(++e);
+    EXPECT_EQ(*e, (DP{CPP{source.skipBytes<5>().firstBytes<1>(), P{Line{2}, Col{9}}, CP{'a'}, P{Line{2}, Col{10}}}}));
+
+    ASSERT_FALSE(++e);
+}
+
+// the indentation has to end at the same column as the code point wise decoding
+TEST(decodePosition, sourceMatchesDecoded) {
+    auto sources = {
+        strings::View{"a\n    b"},
+        strings::View{"\r\n\t\t  b\n"},
+        strings::View{"\n \t \t"},
+        strings::View{"\n                      deep\n                  x"},
+    };
+    for (auto source : sources) {
+        auto expected = text::Position{};
+        for (auto dp : text::decodePosition(strings::utf8Decode(source), text::Config{text::Column{4}})) {
+            dp.visitSome([&](text::CodePointPosition cpp) { expected = cpp.endPosition; });
+        }
+        auto actual = text::Position{};
+        for (auto dp : text::decodePosition(source, text::Config{text::Column{4}})) {
+            dp.visitSome(
+                [&](text::CodePointPosition cpp) { actual = cpp.endPosition; },
+                [&](text::IndentationPosition ip) { actual = ip.endPosition; });
+        }
+        EXPECT_EQ(expected, actual) << source;
+    }
+}
@@ -1,8 +1,11 @@
 #pragma once
 #include "basic/flags.h"
 #include "basic/list.h"
+#include "basic/map.h"
+#include "basic/rope.h"
 #include "basic/str.h"
 #include "basic/u64.h"
+#include "basic/u64list.h"
 
 #include "intrinsic/Function.h"
 #include "intrinsic/Module.h"
@@ -21,14 +24,16 @@ struct Basic {
     static constexpr auto module(Module& mod) {
         // mod.template type<bool>();
         mod.template type<api::U64>();
+        mod.template type<api::U64List>();
         // mod.template type<api::F64>();
         mod.template type<api::String>();
-        // mod.template type<api::Rope>();
+        mod.template type<api::Rope>();
         mod.template type<api::Flags>();
         // mod.template type<api::Enum>();
         // mod.template type<api::Variant>();
         // mod.template type<api::List>();
-        // mod.template type<api::Map>();
+        // mod.template type<api::Map>(); // needs constructed types for keys and values
+        mod.template type<api::U64Map>();
     }
 };
 
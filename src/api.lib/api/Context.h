@@ -10,10 +10,7 @@
 #include "intrinsic/Module.h"
 #include "intrinsic/Type.h"
 
-#include "strings/Rope.ostream.h"
-
-// TODO(arBmind): remove dependency
-#include <iostream>
+#include "strings/Rope.h"
 
 namespace intrinsic {
 
@@ -49,6 +46,28 @@ struct TypeOf<ContextInterface*> {
         }
     };
 
+    // with lazy modules the body is only parsed once a member is looked up
+    static void parseModuleBody(const instance::ModulePtr& module, const Block& block, ImplicitContext context) {
+        auto parse = context.v->lazyModuleParser();
+        if (!parse) {
+            auto localsPtr = instance::LocalScopePtr(module, &module->locals);
+            auto moduleScope = std::make_shared<instance::Scope>(std::move(localsPtr), context.v->parserScope);
+            auto parsedBlock = context.v->parse(block.v.block, moduleScope);
+            (void)parsedBlock; // TODO(arBmind): use parsedBlock
+            return;
+        }
+        // note: the module owns this lambda - an owning locals pointer would keep the module alive forever
+        module->deferBody([parse = std::move(parse),
+                           blockLiteral = block.v.block,
+                           parent = context.v->parserScope,
+                           locals = &module->locals] {
+            auto localsPtr = instance::LocalScopePtr(std::shared_ptr<void>{}, locals);
+            auto moduleScope = std::make_shared<instance::Scope>(std::move(localsPtr), parent);
+            auto parsedBlock = parse(blockLiteral, moduleScope);
+            (void)parsedBlock; // TODO(arBmind): use parsedBlock
+        });
+    }
+
     static void declareModule(Label label, Block block, ModuleResult& res, ImplicitContext context) {
         auto name = label.v.input;
         auto range = context.v->parserScope->locals->byName(name);
@@ -56,10 +75,8 @@ struct TypeOf<ContextInterface*> {
             auto& node = range.frontValue();
             if (range.single() && node.holds<instance::ModulePtr>()) {
                 auto& module = node.get<instance::ModulePtr>();
-                auto localsPtr = instance::LocalScopePtr(module, &module->locals);
-                auto moduleScope = std::make_shared<instance::Scope>(std::move(localsPtr), context.v->parserScope);
-                auto parsedBlock = context.v->parse(block.v.block, moduleScope);
-                (void)parsedBlock; // TODO(arBmind): use parsedBlock
+                (void)module->members(); // the previous body has to declare its members first
+                parseModuleBody(module, block, context);
                 res.v = module.get();
             }
             else {
@@ -80,11 +97,7 @@ struct TypeOf<ContextInterface*> {
                 auto module = std::make_shared<instance::Module>();
                 module->name = strings::to_string(name);
                 context.v->parserScope->emplace(module);
-
-                auto localsPtr = instance::LocalScopePtr(module, &module->locals);
-                auto moduleScope = std::make_shared<instance::Scope>(std::move(localsPtr), context.v->parserScope);
-                auto parsedBlock = context.v->parse(block.v.block, moduleScope);
-                (void)parsedBlock; // TODO(arBmind): use parsedBlock
+                parseModuleBody(module, block, context);
                 return module;
             }();
 
@@ -105,22 +118,6 @@ struct TypeOf<ContextInterface*> {
         }
     };
 
-    static auto typeFromNode(const parser::TypeExpr& node) -> parser::TypeView {
-        // TODO(arBmind): somehow handle computed types
-        return node.visit(
-            [](const parser::TypeReference& tr) { return tr.type; }, //
-            [](const parser::ModuleReference& mr) -> parser::TypeView {
-                auto typeRange = mr.module->locals.byName(parser::nameOfType());
-                if (typeRange.single()) {
-                    const auto& type = typeRange.frontValue().get<instance::TypePtr>();
-                    return type.get();
-                }
-                return {}; // error module is not a type
-            },
-            [](const auto&) -> parser::TypeView { return {}; } // not a type
-        );
-    }
-
     static void declareVariable(NameTypeValue ntv, VariableInitResult& res, ImplicitContext context) {
         if (!ntv.v.name || !ntv.v.type) {
             return; // error
@@ -132,7 +129,7 @@ struct TypeOf<ContextInterface*> {
         auto variable = [&] {
             auto variable = std::make_shared<instance::Variable>();
             variable->name = name;
-            if (ntv.v.type) variable->type = typeFromNode(ntv.v.type.value());
+            if (ntv.v.type) variable->type = instance::typeOf(ntv.v.type.value());
             // TODO(arBmind): else use type of value!
             return variable;
         }();
@@ -192,8 +189,8 @@ struct TypeOf<ContextInterface*> {
                 function->flags |= instance::FunctionFlag::compile_time; // TODO(arBmind): allow custom flags
 
                 auto addParametersFromNtvTuple = [&](instance::ParameterSide side,
-                                                     parser::NameTypeValueTuple& ntvTuple) {
-                    for (auto& ntv : ntvTuple.tuple) {
+                                                     const parser::NameTypeValueTuple& ntvTuple) {
+                    for (const auto& ntv : *ntvTuple.tuple) {
                         // TODO(arBmind): check double parameter names
                         auto parameter = [&] {
                             auto parameter = std::make_shared<instance::Parameter>();
@@ -267,6 +264,7 @@ struct Rebuild {
     static constexpr auto info() {
         return ModuleInfo{Name{"Rebuild"}}; //
     }
+    using ImplicitContext = TypeOf<ContextInterface*>::ImplicitContext;
 
     struct SayLiteral {
         parser::StringLiteral v;
@@ -274,9 +272,20 @@ struct Rebuild {
             return ParameterInfo{Name{"literal"}, ParameterSide::Right}; //
         }
     };
-    static void debugSay(SayLiteral literal) {
-        auto text = literal.v.value.text;
-        std::cout << text << '\n';
+    static void debugSay(SayLiteral literal, ImplicitContext context) {
+        literal.v.value.text.forEachPiece([&](strings::View piece) { context.v->output(piece); });
+        context.v->output(strings::View{"\n"});
+    }
+
+    struct WriteRope {
+        api::Rope v;
+        static constexpr auto info() {
+            return ParameterInfo{Name{"rope"}, ParameterSide::Right, ParameterFlag::Reference}; //
+        }
+    };
+    /// streams all pieces into the output - the rope is never flattened
+    static void write(const WriteRope& rope, ImplicitContext context) {
+        rope.v.forEachPiece([&](strings::View piece) { context.v->output(piece); });
     }
 
     template<class Module>
@@ -291,6 +300,9 @@ struct Rebuild {
         mod.function(ptr_to<debugSay>, [] {
             return FunctionInfo{Name{".say"}, FunctionFlag::CompileTimeSideEffects};
         }());
+        mod.function(ptr_to<write>, [] {
+            return FunctionInfo{Name{".write"}, FunctionFlag::CompileTimeSideEffects};
+        }());
 
         // mod.template type<compiler::Scope>();
         // mod.template type<compiler::LocalScope>();
@@ -49,8 +49,25 @@ struct TypeOf<parser::ScopedBlockLiteral> {
         return info;
     }
 
+    struct Literal {
+        nesting::BlockLiteral v;
+        static constexpr auto info() {
+            return ParameterInfo{Name{"literal"}, ParameterSide::Right, ParameterFlag::Reference}; //
+        }
+    };
+    struct Result {
+        parser::ScopedBlockLiteral v;
+        static constexpr auto info() {
+            return ParameterInfo{Name{"result"}, ParameterSide::Result, ParameterFlag::Assignable}; //
+        }
+    };
+    static void implicitFrom(const Literal& literal, Result& res) { res.v = parser::ScopedBlockLiteral{literal.v}; }
+
     template<class Module>
-    static constexpr auto module(Module&) {
+    static constexpr auto module(Module& mod) {
+        mod.function(ptr_to<implicitFrom>, [] {
+            return FunctionInfo{Name{".implicitFrom"}, FunctionFlag::CompileTimeOnly}; //
+        }());
         // TODO(arBmind): add API
     }
 };
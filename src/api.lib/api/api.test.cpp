@@ -1,10 +1,18 @@
 
+#include "api/basic/map.h"
+#include "api/basic/rope.h"
 #include "api/basic/u64.h"
+#include "api/basic/u64list.h"
+
+#include "instance/Type.builder.h"
 
 #include "strings/Rope.ostream.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <string>
+
 using Radix = scanner::Radix;
 
 struct U64ImplicitFromData {
@@ -48,3 +56,143 @@ INSTANTIATE_TEST_CASE_P(
         U64ImplicitFromData{"999", strings::Rope{strings::View{"999"}}, Radix::decimal, 999},
         U64ImplicitFromData{"0x999", strings::Rope{strings::View{"999"}}, Radix::hex, 0x999} //
         ));
+
+TEST(U64List, bulk) {
+    using List = intrinsic::TypeOf<api::U64List>;
+    auto list = List::Result{};
+    List::iota({5}, {10}, list); // 10 11 12 13 14
+    EXPECT_EQ(list.v.v, (std::vector<uint64_t>{10, 11, 12, 13, 14}));
+
+    auto scalar = List::ScalarResult{};
+    List::sum({list.v}, scalar);
+    EXPECT_EQ(scalar.v, 60u);
+    List::min({list.v}, scalar);
+    EXPECT_EQ(scalar.v, 10u);
+    List::max({list.v}, scalar);
+    EXPECT_EQ(scalar.v, 14u);
+
+    auto twos = List::Result{};
+    List::fill({3}, {2}, twos);
+    auto product = List::Result{};
+    List::mul({list.v}, {twos.v}, product); // shorter list wins
+    EXPECT_EQ(product.v.v, (std::vector<uint64_t>{20, 22, 24}));
+
+    auto mask = List::Result{};
+    List::less({list.v}, {12}, mask);
+    EXPECT_EQ(mask.v.v, (std::vector<uint64_t>{~0ull, ~0ull, 0, 0, 0}));
+}
+
+TEST(U64List, sortAndFind) {
+    using List = intrinsic::TypeOf<api::U64List>;
+    auto sorted = List::Result{};
+    List::sort({api::U64List{{9, 3, 7, 1, 3}}}, sorted);
+    EXPECT_EQ(sorted.v.v, (std::vector<uint64_t>{1, 3, 3, 7, 9}));
+
+    auto index = List::ScalarResult{};
+    for (auto [value, expected] : std::vector<std::pair<uint64_t, uint64_t>>{{0, 0}, {3, 1}, {4, 3}, {9, 4}, {10, 5}}) {
+        List::find({sorted.v}, {value}, index);
+        EXPECT_EQ(index.v, expected) << "value " << value;
+    }
+    List::find({api::U64List{}}, {1}, index);
+    EXPECT_EQ(index.v, 0u);
+}
+
+TEST(Map, trivialKeys) {
+    auto map = api::Map{api::u64Type(), api::u64Type()};
+    for (auto k = uint64_t{}; k < 1000; k++) {
+        auto v = k * k;
+        EXPECT_TRUE(map.insert(&k, &v));
+    }
+    for (auto k = uint64_t{}; k < 1000; k += 2) EXPECT_TRUE(map.erase(&k));
+    auto key = uint64_t{7};
+    auto value = uint64_t{1};
+    EXPECT_FALSE(map.insert(&key, &value)); // replaces
+
+    EXPECT_EQ(map.size(), 500u);
+    EXPECT_EQ(*static_cast<const uint64_t*>(map.find(&key)), 1u);
+    key = 9;
+    EXPECT_EQ(*static_cast<const uint64_t*>(map.find(&key)), 81u);
+    key = 8;
+    EXPECT_EQ(map.find(&key), nullptr);
+
+    auto copy = map;
+    EXPECT_EQ(copy, map);
+    EXPECT_EQ(copy.hash(), map.hash());
+    key = 9;
+    copy.erase(&key);
+    EXPECT_NE(copy, map);
+}
+
+TEST(Map, typedKeys) {
+    static const auto stringType = instance::typeModT<std::string>("string").build();
+    const auto* type = stringType->locals.byName(parser::nameOfType()).frontValue().get<instance::TypePtr>().get();
+    ASSERT_FALSE(type->trivial);
+
+    auto map = api::Map{type, type};
+    auto key = std::string{"a long key that is allocated on the heap"};
+    auto value = std::string{"value"};
+    EXPECT_TRUE(map.insert(&key, &value));
+    for (auto i = 0; i < 100; i++) {
+        auto k = std::to_string(i);
+        map.insert(&k, &k); // grows and relocates the first entry
+    }
+    EXPECT_EQ(*static_cast<const std::string*>(map.find(&key)), "value");
+    EXPECT_TRUE(map.erase(&key));
+    EXPECT_EQ(map.find(&key), nullptr);
+    EXPECT_EQ(map.size(), 100u);
+}
+
+TEST(U64Map, intrinsics) {
+    using MapOf = intrinsic::TypeOf<api::U64Map>;
+    auto target = MapOf::Target{};
+    MapOf::insert(target, {3}, {30});
+    MapOf::insert(target, {1}, {10});
+    MapOf::insert(target, {2}, {20});
+    MapOf::erase(target, {2});
+
+    auto result = MapOf::Result{};
+    MapOf::find({target.v}, {3}, result);
+    EXPECT_EQ(result.v, 30u);
+    MapOf::contains({target.v}, {2}, result);
+    EXPECT_EQ(result.v, 0u);
+    MapOf::size({target.v}, result);
+    EXPECT_EQ(result.v, 2u);
+
+    auto keys = MapOf::ListResult{};
+    MapOf::keys({target.v}, keys);
+    std::sort(keys.v.v.begin(), keys.v.v.end());
+    EXPECT_EQ(keys.v.v, (std::vector<uint64_t>{1, 3}));
+}
+
+TEST(Rope, intrinsics) {
+    using RopeOf = intrinsic::TypeOf<api::Rope>;
+    auto target = RopeOf::Target{};
+    RopeOf::appendLiteral(target, {parser::StringLiteral{{}, {strings::Rope{strings::View{"Hello"}}}}});
+    RopeOf::appendCodePoint(target, {' '});
+    RopeOf::append(target, {strings::Rope{strings::View{"World"}}});
+
+    auto length = RopeOf::LengthResult{};
+    RopeOf::length({target.v}, length);
+    EXPECT_EQ(length.v, 11u);
+
+    auto slice = RopeOf::Result{};
+    RopeOf::slice({target.v}, {4}, {3}, slice);
+    EXPECT_EQ(slice.v, strings::View{"o W"});
+
+    auto flat = RopeOf::StringResult{};
+    RopeOf::flatten({target.v}, flat);
+    EXPECT_EQ(flat.v, strings::String{"Hello World"});
+}
+
+TEST(Rope, invalidCodePoints) {
+    using RopeOf = intrinsic::TypeOf<api::Rope>;
+    auto target = RopeOf::Target{};
+    RopeOf::appendCodePoint(target, {0xD800}); // surrogate
+    RopeOf::appendCodePoint(target, {0x11'0000});
+    RopeOf::appendCodePoint(target, {0x1'0000'0041}); // not truncated to 'A'
+    RopeOf::appendCodePoint(target, {0x10'FFFF});
+
+    auto flat = RopeOf::StringResult{};
+    RopeOf::flatten({target.v}, flat);
+    EXPECT_EQ(flat.v, strings::String{"\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD\xF4\x8F\xBF\xBF"});
+}
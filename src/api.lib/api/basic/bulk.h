@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/// bulk kernels for contiguous u64 storage
+// plain counted loops over restrict pointers without early exits - compilers turn them into SIMD code
+// reductions use independent lanes, so the vectorizer does not have to reorder the accumulation
+namespace api::bulk {
+
+using U64 = uint64_t;
+constexpr auto lanes = size_t{4};
+
+inline void fill(U64* __restrict out, size_t count, U64 value) {
+    for (auto i = size_t{}; i < count; i++) out[i] = value;
+}
+
+inline void iota(U64* __restrict out, size_t count, U64 start) {
+    for (auto i = size_t{}; i < count; i++) out[i] = start + i;
+}
+
+inline auto sum(const U64* __restrict in, size_t count) -> U64 {
+    U64 lane[lanes] = {};
+    auto i = size_t{};
+    for (; i + lanes <= count; i += lanes)
+        for (auto l = size_t{}; l < lanes; l++) lane[l] += in[i + l];
+    for (; i < count; i++) lane[0] += in[i];
+    return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+}
+
+/// smallest element - ~0 for no elements
+inline auto min(const U64* __restrict in, size_t count) -> U64 {
+    U64 lane[lanes] = {~U64{}, ~U64{}, ~U64{}, ~U64{}};
+    auto i = size_t{};
+    for (; i + lanes <= count; i += lanes)
+        for (auto l = size_t{}; l < lanes; l++) lane[l] = std::min(lane[l], in[i + l]);
+    for (; i < count; i++) lane[0] = std::min(lane[0], in[i]);
+    return std::min(std::min(lane[0], lane[1]), std::min(lane[2], lane[3]));
+}
+
+/// largest element - 0 for no elements
+inline auto max(const U64* __restrict in, size_t count) -> U64 {
+    U64 lane[lanes] = {};
+    auto i = size_t{};
+    for (; i + lanes <= count; i += lanes)
+        for (auto l = size_t{}; l < lanes; l++) lane[l] = std::max(lane[l], in[i + l]);
+    for (; i < count; i++) lane[0] = std::max(lane[0], in[i]);
+    return std::max(std::max(lane[0], lane[1]), std::max(lane[2], lane[3]));
+}
+
+inline void add(const U64* __restrict a, const U64* __restrict b, U64* __restrict out, size_t count) {
+    for (auto i = size_t{}; i < count; i++) out[i] = a[i] + b[i];
+}
+
+inline void mul(const U64* __restrict a, const U64* __restrict b, U64* __restrict out, size_t count) {
+    for (auto i = size_t{}; i < count; i++) out[i] = a[i] * b[i];
+}
+
+/// ~0 for every element less than bound, 0 otherwise
+inline void lessMask(const U64* __restrict in, size_t count, U64 bound, U64* __restrict out) {
+    for (auto i = size_t{}; i < count; i++) out[i] = U64{0} - static_cast<U64>(in[i] < bound);
+}
+
+inline void sort(U64* data, size_t count) { std::sort(data, data + count); }
+
+/// index of the first element not less than value (count if there is none) - data has to be sorted
+// branchless: the loop runs log2(count) steps with a conditional move instead of a mispredicted jump
+inline auto lowerBound(const U64* data, size_t count, U64 value) -> size_t {
+    if (count == 0) return 0;
+    const auto* base = data;
+    auto length = count;
+    while (length > 1) {
+        auto half = length / 2;
+        base = base[half] < value ? base + half : base;
+        length -= half;
+    }
+    return static_cast<size_t>(base - data) + static_cast<size_t>(*base < value);
+}
+
+} // namespace api::bulk
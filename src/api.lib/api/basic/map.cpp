@@ -0,0 +1,252 @@
+#include "map.h"
+
+#include "instance/Type.builder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace api {
+
+namespace {
+
+constexpr auto alignUp(size_t value, size_t alignment) -> size_t {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// spreads the bits - std::hash of integers is the identity, which clusters in the low bits
+constexpr auto mix(size_t hash) -> size_t {
+    auto h = static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15u;
+    return static_cast<size_t>(h ^ (h >> 32u));
+}
+
+void cloneValue(TypeView type, void* dest, const void* source) {
+    if (type->trivial)
+        std::memcpy(dest, source, type->size);
+    else
+        type->cloneFunc(dest, source);
+}
+
+void destroyValue(TypeView type, void* dest) {
+    if (!type->trivial) type->destructFunc(dest);
+}
+
+bool equalValue(TypeView type, const void* a, const void* b) {
+    if (type->trivial) return std::memcmp(a, b, type->size) == 0;
+    return type->equalFunc(a, b);
+}
+
+auto hashValue(TypeView type, const void* value) -> size_t {
+    if (type->trivial && type->size == sizeof(uint64_t)) {
+        auto bits = uint64_t{};
+        std::memcpy(&bits, value, sizeof(bits));
+        return static_cast<size_t>(bits);
+    }
+    return type->hashFunc ? type->hashFunc(value) : size_t{}; // no hash - all keys probe one chain
+}
+
+} // namespace
+
+Map::Map(TypeView keyType, TypeView valueType)
+    : m_keyType(keyType)
+    , m_valueType(valueType) {
+    auto keyAlignment = std::max<size_t>(keyType->alignment, 1);
+    auto valueAlignment = std::max<size_t>(valueType->alignment, 1);
+    m_alignment = std::max(keyAlignment, valueAlignment);
+    m_valueOffset = alignUp(keyType->size, valueAlignment);
+    m_stride = std::max<size_t>(alignUp(m_valueOffset + valueType->size, m_alignment), 1);
+}
+
+Map::~Map() { release(); }
+
+Map::Map(const This& o)
+    : m_keyType(o.m_keyType)
+    , m_valueType(o.m_valueType)
+    , m_valueOffset(o.m_valueOffset)
+    , m_stride(o.m_stride)
+    , m_alignment(o.m_alignment) {
+    if (o.m_size == 0) return;
+    rehash(o.m_slots.size());
+    o.forEach([&](const void* key, const void* value) { insert(key, value); });
+}
+
+auto Map::operator=(const This& o) -> This& {
+    if (this != &o) {
+        auto copy = o;
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Map::Map(This&& o) noexcept
+    : m_keyType(o.m_keyType)
+    , m_valueType(o.m_valueType)
+    , m_valueOffset(o.m_valueOffset)
+    , m_stride(o.m_stride)
+    , m_alignment(o.m_alignment)
+    , m_slots(std::move(o.m_slots))
+    , m_entries(std::exchange(o.m_entries, nullptr))
+    , m_size(std::exchange(o.m_size, 0))
+    , m_used(std::exchange(o.m_used, 0)) {
+    o.m_slots.clear();
+}
+
+auto Map::operator=(This&& o) noexcept -> This& {
+    if (this != &o) {
+        release();
+        m_keyType = o.m_keyType;
+        m_valueType = o.m_valueType;
+        m_valueOffset = o.m_valueOffset;
+        m_stride = o.m_stride;
+        m_alignment = o.m_alignment;
+        m_slots = std::move(o.m_slots);
+        o.m_slots.clear();
+        m_entries = std::exchange(o.m_entries, nullptr);
+        m_size = std::exchange(o.m_size, 0);
+        m_used = std::exchange(o.m_used, 0);
+    }
+    return *this;
+}
+
+auto Map::find(const void* key) const -> const void* {
+    auto slot = slotOf(key);
+    return slot != npos ? valueAt(slot) : nullptr;
+}
+
+bool Map::insert(const void* key, const void* value) {
+    if ((m_used + 1) * 8 > m_slots.size() * 7) {
+        // tombstones are dropped by the rehash, only grow if the map is really full
+        auto capacity = std::max<size_t>(m_slots.size(), 8);
+        while ((m_size + 1) * 2 > capacity) capacity *= 2;
+        rehash(capacity);
+    }
+    auto mask = m_slots.size() - 1;
+    auto reuse = npos;
+    for (auto i = mix(hashKey(key)) & mask;; i = (i + 1) & mask) {
+        if (m_slots[i] == Slot::full) {
+            if (!equalKey(keyAt(i), key)) continue;
+            destroyValue(m_valueType, valueAt(i));
+            cloneValue(m_valueType, valueAt(i), value);
+            return false;
+        }
+        if (m_slots[i] == Slot::erased) {
+            if (reuse == npos) reuse = i;
+            continue;
+        }
+        // empty slot - the key is not present
+        if (reuse == npos) {
+            reuse = i;
+            m_used++;
+        }
+        break;
+    }
+    cloneValue(m_keyType, keyAt(reuse), key);
+    cloneValue(m_valueType, valueAt(reuse), value);
+    m_slots[reuse] = Slot::full;
+    m_size++;
+    return true;
+}
+
+bool Map::erase(const void* key) {
+    auto slot = slotOf(key);
+    if (slot == npos) return false;
+    destroyValue(m_keyType, keyAt(slot));
+    destroyValue(m_valueType, valueAt(slot));
+    m_slots[slot] = Slot::erased;
+    m_size--;
+    return true;
+}
+
+void Map::clear() {
+    destroyEntries();
+    std::fill(m_slots.begin(), m_slots.end(), Slot::empty);
+    m_size = 0;
+    m_used = 0;
+}
+
+bool Map::operator==(const This& o) const {
+    if (m_keyType != o.m_keyType || m_valueType != o.m_valueType || m_size != o.m_size) return false;
+    for (auto i = size_t{}; i < m_slots.size(); i++) {
+        if (m_slots[i] != Slot::full) continue;
+        const auto* other = o.find(keyAt(i));
+        if (!other || !equalValue(m_valueType, valueAt(i), other)) return false;
+    }
+    return true;
+}
+
+auto Map::hash() const -> size_t {
+    auto result = meta::hashCombine(meta::hashOf(m_keyType), meta::hashOf(m_valueType));
+    auto entries = size_t{};
+    forEach([&](const void* key, const void* value) {
+        entries += mix(meta::hashCombine(hashValue(m_keyType, key), hashValue(m_valueType, value)));
+    });
+    return meta::hashCombine(result, entries);
+}
+
+auto Map::hashKey(const void* key) const -> size_t { return hashValue(m_keyType, key); }
+
+bool Map::equalKey(const void* a, const void* b) const { return equalValue(m_keyType, a, b); }
+
+auto Map::slotOf(const void* key) const -> size_t {
+    if (m_size == 0) return npos;
+    auto mask = m_slots.size() - 1;
+    for (auto i = mix(hashKey(key)) & mask;; i = (i + 1) & mask) {
+        if (m_slots[i] == Slot::empty) return npos;
+        if (m_slots[i] == Slot::full && equalKey(keyAt(i), key)) return i;
+    }
+}
+
+void Map::rehash(size_t capacity) {
+    auto slots = std::exchange(m_slots, std::vector<Slot>(capacity, Slot::empty));
+    auto* entries = std::exchange(
+        m_entries, static_cast<uint8_t*>(::operator new(capacity * m_stride, std::align_val_t{m_alignment})));
+    auto mask = capacity - 1;
+    for (auto s = size_t{}; s < slots.size(); s++) {
+        if (slots[s] != Slot::full) continue;
+        auto* key = entries + s * m_stride;
+        auto i = mix(hashKey(key)) & mask;
+        while (m_slots[i] != Slot::empty) i = (i + 1) & mask;
+        // relocate by clone and destroy - the type description has no move
+        cloneValue(m_keyType, keyAt(i), key);
+        cloneValue(m_valueType, valueAt(i), key + m_valueOffset);
+        destroyValue(m_keyType, key);
+        destroyValue(m_valueType, key + m_valueOffset);
+        m_slots[i] = Slot::full;
+    }
+    m_used = m_size;
+    if (entries) ::operator delete(entries, std::align_val_t{m_alignment});
+}
+
+void Map::destroyEntries() {
+    forEach([&](void* key, void* value) {
+        destroyValue(m_keyType, key);
+        destroyValue(m_valueType, value);
+    });
+}
+
+void Map::release() {
+    if (!m_entries) return;
+    destroyEntries();
+    ::operator delete(m_entries, std::align_val_t{m_alignment});
+    m_entries = nullptr;
+    m_slots.clear();
+    m_size = 0;
+    m_used = 0;
+}
+
+auto u64Type() -> TypeView {
+    static const auto module = instance::typeModT<U64>(".u64").build();
+    return module->locals.byName(parser::nameOfType()).frontValue().get<instance::TypePtr>().get();
+}
+
+auto operator<<(std::ostream& out, const U64Map& map) -> std::ostream& {
+    out << '{';
+    auto separator = "";
+    map.map.forEach([&](const void* key, const void* value) {
+        out << std::exchange(separator, ", ") << *static_cast<const U64*>(key) << ": "
+            << *static_cast<const U64*>(value);
+    });
+    return out << '}';
+}
+
+} // namespace api
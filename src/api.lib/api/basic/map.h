@@ -0,0 +1,214 @@
+#pragma once
+#include "u64.h"
+#include "u64list.h"
+
+#include "intrinsic/Function.h"
+#include "intrinsic/Type.h"
+
+#include "parser/Type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace api {
+
+using TypeView = parser::TypeView;
+
+/// hash map with open addressing for keys and values described by their Type
+// linear probing over a power of two slot count - erased slots stay tombstones until the next rehash
+// trivial keys and values are copied and compared as bytes, u64 sized trivial keys are hashed inline
+struct Map {
+    using This = Map;
+
+    Map() = default;
+    Map(TypeView keyType, TypeView valueType);
+    ~Map();
+
+    Map(const This& o);
+    auto operator=(const This& o) -> This&;
+    Map(This&& o) noexcept;
+    auto operator=(This&& o) noexcept -> This&;
+
+    [[nodiscard]] auto keyType() const -> TypeView { return m_keyType; }
+    [[nodiscard]] auto valueType() const -> TypeView { return m_valueType; }
+    [[nodiscard]] auto size() const -> size_t { return m_size; }
+    [[nodiscard]] auto empty() const -> bool { return m_size == 0; }
+
+    /// value stored for key - nullptr if the key is missing
+    [[nodiscard]] auto find(const void* key) const -> const void*;
+
+    /// true if the key was new - the value of an existing key is replaced
+    bool insert(const void* key, const void* value);
+
+    /// true if the key was present
+    bool erase(const void* key);
+
+    void clear();
+
+    /// calls f(key, value) for every entry - the order is unspecified
+    template<class F>
+    void forEach(F&& f) const {
+        for (auto i = size_t{}; i < m_slots.size(); i++)
+            if (m_slots[i] == Slot::full) f(keyAt(i), valueAt(i));
+    }
+
+    [[nodiscard]] bool operator==(const This& o) const;
+    [[nodiscard]] bool operator!=(const This& o) const { return !(*this == o); }
+
+    /// independent of the insertion order
+    [[nodiscard]] auto hash() const -> size_t;
+
+private:
+    enum class Slot : uint8_t { empty, full, erased };
+    static constexpr auto npos = ~size_t{};
+
+    [[nodiscard]] auto keyAt(size_t i) const -> void* { return m_entries + i * m_stride; }
+    [[nodiscard]] auto valueAt(size_t i) const -> void* { return m_entries + i * m_stride + m_valueOffset; }
+    [[nodiscard]] auto hashKey(const void* key) const -> size_t;
+    [[nodiscard]] bool equalKey(const void* a, const void* b) const;
+    [[nodiscard]] auto slotOf(const void* key) const -> size_t; // full slot with the key or npos
+
+    void rehash(size_t capacity);
+    void destroyEntries();
+    void release();
+
+    TypeView m_keyType{};
+    TypeView m_valueType{};
+    size_t m_valueOffset{};
+    size_t m_stride{};
+    size_t m_alignment{};
+    std::vector<Slot> m_slots{};
+    uint8_t* m_entries{};
+    size_t m_size{}; // full slots
+    size_t m_used{}; // full and erased slots
+};
+
+/// description of u64 values - used by U64Map
+[[nodiscard]] auto u64Type() -> TypeView;
+
+/// map from u64 to u64 - inserting and erasing updates the map in place
+struct U64Map {
+    Map map{u64Type(), u64Type()};
+
+    [[nodiscard]] bool operator==(const U64Map& o) const { return map == o.map; }
+    [[nodiscard]] bool operator!=(const U64Map& o) const { return map != o.map; }
+    [[nodiscard]] auto hash() const -> size_t { return map.hash(); }
+};
+
+auto operator<<(std::ostream& out, const U64Map& map) -> std::ostream&;
+
+} // namespace api
+
+namespace intrinsic {
+
+template<>
+struct TypeOf<api::U64Map> {
+    static constexpr auto info() {
+        auto info = TypeInfo{};
+        info.name = Name{".u64map"};
+        info.flags = TypeFlag::CompileTime | TypeFlag::RunTime;
+        return info;
+    }
+
+    struct Target {
+        api::U64Map v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"map"};
+            info.side = ParameterSide::Left;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct Left {
+        api::U64Map v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"map"};
+            info.side = ParameterSide::Left;
+            info.flags = ParameterFlag::Reference; // maps are not copied
+            return info;
+        }
+    };
+    struct Key {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"key"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+    struct Value {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"value"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+    struct Result {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct ListResult {
+        api::U64List v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+
+    static void insert(Target& map, Key key, Value value) { map.v.map.insert(&key.v, &value.v); }
+    static void erase(Target& map, Key key) { map.v.map.erase(&key.v); }
+    /// value of the key - 0 if the key is missing
+    static void find(const Left& map, Key key, Result& res) {
+        const auto* value = map.v.map.find(&key.v);
+        res.v = value ? *static_cast<const api::U64*>(value) : 0;
+    }
+    static void contains(const Left& map, Key key, Result& res) { res.v = map.v.map.find(&key.v) ? 1 : 0; }
+    static void size(const Left& map, Result& res) { res.v = map.v.map.size(); }
+    static void keys(const Left& map, ListResult& res) {
+        res.v.v.clear();
+        map.v.map.forEach([&](const void* key, const void*) { res.v.v.push_back(*static_cast<const api::U64*>(key)); });
+    }
+    static void values(const Left& map, ListResult& res) {
+        res.v.v.clear();
+        map.v.map.forEach(
+            [&](const void*, const void* value) { res.v.v.push_back(*static_cast<const api::U64*>(value)); });
+    }
+
+    // no flags - the functions are available at compile time and at run time
+    template<size_t N>
+    static constexpr auto plain(const char (&name)[N]) {
+        auto info = FunctionInfo{};
+        info.name = Name{name};
+        return info;
+    }
+
+    template<class Module>
+    static constexpr auto module(Module& mod) {
+        mod.function(ptr_to<insert>, plain("insert"));
+        mod.function(ptr_to<erase>, plain("erase"));
+        mod.function(ptr_to<find>, plain("find"));
+        mod.function(ptr_to<contains>, plain("contains"));
+        mod.function(ptr_to<size>, plain("size"));
+        mod.function(ptr_to<keys>, plain("keys"));
+        mod.function(ptr_to<values>, plain("values"));
+    }
+};
+
+} // namespace intrinsic
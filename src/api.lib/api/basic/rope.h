@@ -0,0 +1,167 @@
+#pragma once
+#include "str.h"
+#include "u64.h"
+
+#include "intrinsic/Function.h"
+#include "intrinsic/Type.h"
+
+#include "parser/Expression.h"
+
+#include "strings/Rope.h"
+#include "strings/Rope.ostream.h"
+
+namespace api {
+
+/// string builder - appends only add pieces, the text is joined once by flatten
+using Rope = strings::Rope;
+
+} // namespace api
+
+namespace intrinsic {
+
+template<>
+struct TypeOf<api::Rope> {
+    static constexpr auto info() {
+        auto info = TypeInfo{};
+        info.name = Name{".rope"};
+        info.flags = TypeFlag::CompileTime;
+        return info;
+    }
+
+    struct Target {
+        api::Rope v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"rope"};
+            info.side = ParameterSide::Left;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct Left {
+        api::Rope v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"rope"};
+            info.side = ParameterSide::Left;
+            info.flags = ParameterFlag::Reference; // pieces are not copied
+            return info;
+        }
+    };
+    struct Right {
+        api::Rope v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"other"};
+            info.side = ParameterSide::Right;
+            info.flags = ParameterFlag::Reference;
+            return info;
+        }
+    };
+    struct Literal {
+        parser::StringLiteral v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"literal"};
+            info.side = ParameterSide::Right;
+            info.flags = ParameterFlag::Reference;
+            return info;
+        }
+    };
+    struct CodePoint {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"codePoint"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+    struct Start {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"start"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+    struct Count {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"count"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+    struct Result {
+        api::Rope v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct LengthResult {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct StringResult {
+        api::String v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+
+    // appends take the pieces over - the literal text is a rope itself
+    static void appendLiteral(Target& rope, const Literal& literal) { rope.v += literal.v.value.text; }
+    static void append(Target& rope, const Right& other) { rope.v += other.v; }
+    /// surrogates and values beyond U+10FFFF are replaced by U+FFFD
+    static void appendCodePoint(Target& rope, CodePoint codePoint) {
+        constexpr auto replacement = strings::CodePoint{0xFFFD};
+        auto cp = codePoint.v < 0x11'0000 ? strings::CodePoint{static_cast<uint32_t>(codePoint.v)} : replacement;
+        rope.v += cp.isSurrogate() ? replacement : cp;
+    }
+
+    /// bytes [start, start + count) - clamped to the rope and shrunk to whole code points
+    static void slice(const Left& rope, Start start, Count count, Result& res) {
+        res.v = rope.v.slice(strings::Counter{start.v}, strings::Counter{count.v});
+    }
+    static void length(const Left& rope, LengthResult& res) { res.v = rope.v.byteCount().v; }
+
+    /// joins all pieces into a single allocation
+    static void flatten(const Left& rope, StringResult& res) { res.v = api::String{rope.v}; }
+
+    template<size_t N>
+    static constexpr auto compileTime(const char (&name)[N]) {
+        auto info = FunctionInfo{};
+        info.name = Name{name};
+        info.flags = FunctionFlag::CompileTimeOnly;
+        return info;
+    }
+
+    template<class Module>
+    static constexpr auto module(Module& mod) {
+        mod.function(ptr_to<appendLiteral>, compileTime("appendLiteral"));
+        mod.function(ptr_to<append>, compileTime("append"));
+        mod.function(ptr_to<appendCodePoint>, compileTime("appendCodePoint"));
+        mod.function(ptr_to<slice>, compileTime("slice"));
+        mod.function(ptr_to<length>, compileTime("length"));
+        mod.function(ptr_to<flatten>, compileTime("flatten"));
+    }
+};
+
+} // namespace intrinsic
@@ -0,0 +1,163 @@
+#pragma once
+#include "bulk.h"
+#include "u64.h"
+
+#include "intrinsic/Function.h"
+#include "intrinsic/Type.h"
+
+#include "meta/Hash.h"
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace api {
+
+/// contiguous list of u64 values - all operations work on the whole list
+struct U64List {
+    std::vector<U64> v{};
+
+    bool operator==(const U64List& o) const { return v == o.v; }
+    bool operator!=(const U64List& o) const { return v != o.v; }
+
+    [[nodiscard]] auto hash() const -> size_t { return meta::hashRange(v); }
+};
+
+inline auto operator<<(std::ostream& out, const U64List& list) -> std::ostream& {
+    out << '[';
+    auto separator = "";
+    for (auto value : list.v) out << std::exchange(separator, ", ") << value;
+    return out << ']';
+}
+
+} // namespace api
+
+namespace intrinsic {
+
+template<>
+struct TypeOf<api::U64List> {
+    static constexpr auto info() {
+        auto info = TypeInfo{};
+        info.name = Name{".u64list"};
+        info.flags = TypeFlag::CompileTime | TypeFlag::RunTime;
+        return info;
+    }
+
+    struct Result {
+        api::U64List v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct ScalarResult {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"result"};
+            info.side = ParameterSide::Result;
+            info.flags = ParameterFlag::Assignable;
+            return info;
+        }
+    };
+    struct Left {
+        api::U64List v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"left"};
+            info.side = ParameterSide::Left;
+            info.flags = ParameterFlag::Reference; // lists are not copied
+            return info;
+        }
+    };
+    struct Right {
+        api::U64List v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"right"};
+            info.side = ParameterSide::Right;
+            info.flags = ParameterFlag::Reference; // lists are not copied
+            return info;
+        }
+    };
+    struct Count {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"count"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+    struct Value {
+        api::U64 v;
+        static constexpr auto info() {
+            auto info = ParameterInfo{};
+            info.name = Name{"value"};
+            info.side = ParameterSide::Right;
+            return info;
+        }
+    };
+
+    static void fill(Count count, Value value, Result& res) {
+        res.v.v.resize(count.v);
+        api::bulk::fill(res.v.v.data(), res.v.v.size(), value.v);
+    }
+    static void iota(Count count, Value start, Result& res) {
+        res.v.v.resize(count.v);
+        api::bulk::iota(res.v.v.data(), res.v.v.size(), start.v);
+    }
+    static void sum(const Left& l, ScalarResult& res) { res.v = api::bulk::sum(l.v.v.data(), l.v.v.size()); }
+    static void min(const Left& l, ScalarResult& res) { res.v = api::bulk::min(l.v.v.data(), l.v.v.size()); }
+    static void max(const Left& l, ScalarResult& res) { res.v = api::bulk::max(l.v.v.data(), l.v.v.size()); }
+
+    // element-wise - the result is as long as the shorter list
+    static void add(const Left& l, const Right& r, Result& res) {
+        res.v.v.resize(std::min(l.v.v.size(), r.v.v.size()));
+        api::bulk::add(l.v.v.data(), r.v.v.data(), res.v.v.data(), res.v.v.size());
+    }
+    static void mul(const Left& l, const Right& r, Result& res) {
+        res.v.v.resize(std::min(l.v.v.size(), r.v.v.size()));
+        api::bulk::mul(l.v.v.data(), r.v.v.data(), res.v.v.data(), res.v.v.size());
+    }
+    static void less(const Left& l, Value bound, Result& res) {
+        res.v.v.resize(l.v.v.size());
+        api::bulk::lessMask(l.v.v.data(), l.v.v.size(), bound.v, res.v.v.data());
+    }
+    static void sort(const Left& l, Result& res) {
+        res.v = l.v;
+        api::bulk::sort(res.v.v.data(), res.v.v.size());
+    }
+    /// position of the first element that is not less than value - the list has to be sorted
+    static void find(const Left& l, Value value, ScalarResult& res) {
+        res.v = api::bulk::lowerBound(l.v.v.data(), l.v.v.size(), value.v);
+    }
+
+    // no flags - the functions are available at compile time and at run time
+    template<size_t N>
+    static constexpr auto plain(const char (&name)[N]) {
+        auto info = FunctionInfo{};
+        info.name = Name{name};
+        return info;
+    }
+
+    template<class Module>
+    static constexpr auto module(Module& mod) {
+        mod.function(ptr_to<fill>, plain("fill"));
+        mod.function(ptr_to<iota>, plain("iota"));
+        mod.function(ptr_to<sum>, plain("sum"));
+        mod.function(ptr_to<min>, plain("min"));
+        mod.function(ptr_to<max>, plain("max"));
+        mod.function(ptr_to<add>, plain("add"));
+        mod.function(ptr_to<mul>, plain("mul"));
+        mod.function(ptr_to<less>, plain("less"));
+        mod.function(ptr_to<sort>, plain("sort"));
+        mod.function(ptr_to<find>, plain("find"));
+    }
+};
+
+} // namespace intrinsic
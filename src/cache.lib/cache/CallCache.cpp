@@ -0,0 +1,176 @@
+#include "CallCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#ifdef _WIN32
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace cache {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// file layout:
+// magic "rcc" - version - key size (8 bytes little endian) - key - value
+constexpr uint8_t magic[] = {'r', 'c', 'c', 1};
+constexpr auto headerSize = sizeof(magic) + 8;
+
+// FNV-1a - stable across compiler runs and platforms
+auto fileNameOf(const Bytes& key) -> std::string {
+    auto hash = uint64_t{0xcbf29ce484222325};
+    for (auto b : key) hash = (hash ^ b) * 0x100000001b3;
+    auto name = std::string(16, '0');
+    for (auto i = 0u; i < 16u; i++) name[15 - i] = "0123456789abcdef"[(hash >> (4u * i)) & 0xFu];
+    return name;
+}
+
+bool isEntryName(const std::string& name) {
+    return name.size() == 16 && std::all_of(name.begin(), name.end(), [](char c) {
+               return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+           });
+}
+
+auto processId() -> uint64_t {
+#ifdef _WIN32
+    return static_cast<uint64_t>(_getpid());
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+auto readFile(const Path& path) -> Bytes {
+    auto in = std::ifstream{path, std::ios::binary};
+    return Bytes{std::istreambuf_iterator<char>{in}, {}};
+}
+
+} // namespace
+
+CallCache::CallCache(Path directory, uint64_t maxBytes, Bytes buildId)
+    : m_directory(std::move(directory))
+    , m_maxBytes(maxBytes)
+    , m_buildId(std::move(buildId)) {
+    auto ec = std::error_code{};
+    fs::create_directories(m_directory, ec);
+
+    struct Found {
+        fs::file_time_type time{};
+        std::string name{};
+        uint64_t size{};
+    };
+    auto found = std::vector<Found>{};
+    for (const auto& file : fs::directory_iterator{m_directory, ec}) {
+        auto name = file.path().filename().string();
+        if (!file.is_regular_file(ec) || !isEntryName(name)) continue;
+        found.push_back({file.last_write_time(ec), name, file.file_size(ec)});
+    }
+    // last write time is updated on every use
+    std::sort(found.begin(), found.end(), [](auto& l, auto& r) { return l.time > r.time; });
+    for (auto& f : found) {
+        auto it = m_entries.insert(m_entries.end(), Entry{f.name, f.size});
+        m_byName.emplace(std::move(f.name), it);
+        m_bytes += f.size;
+    }
+    evict();
+}
+
+auto CallCache::load(const Bytes& callKey) -> const Bytes* {
+    auto key = fullKey(callKey);
+    auto name = fileNameOf(key);
+    if (m_byName.find(name) == m_byName.end()) {
+        m_stats.misses++;
+        return nullptr;
+    }
+    auto path = m_directory / name;
+    auto bytes = readFile(path);
+    auto keySize = uint64_t{};
+    auto valid = bytes.size() >= headerSize && std::equal(std::begin(magic), std::end(magic), bytes.begin());
+    if (valid) {
+        for (auto i = 0u; i < 8u; i++) keySize |= uint64_t{bytes[sizeof(magic) + i]} << (8u * i);
+        valid = keySize == key.size() && bytes.size() - headerSize >= keySize &&
+            std::equal(key.begin(), key.end(), bytes.begin() + headerSize);
+    }
+    if (!valid) {
+        m_stats.misses++; // other key with the same hash or damaged file
+        return nullptr;
+    }
+    auto ec = std::error_code{};
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    use(name, bytes.size());
+
+    m_stats.hits++;
+    auto valueBegin = bytes.begin() + static_cast<ptrdiff_t>(headerSize + keySize);
+    m_loaded.assign(valueBegin, bytes.end());
+    return &m_loaded;
+}
+
+void CallCache::store(const Bytes& callKey, const Bytes& value) {
+    auto key = fullKey(callKey);
+    auto name = fileNameOf(key);
+    auto bytes = Bytes{std::begin(magic), std::end(magic)};
+    for (auto i = 0u; i < 8u; i++) bytes.push_back(static_cast<uint8_t>(key.size() >> (8u * i)));
+    bytes.insert(bytes.end(), key.begin(), key.end());
+    bytes.insert(bytes.end(), value.begin(), value.end());
+
+    // write and rename, so concurrent compilers never read a partial file
+    // the temporary name is unique per process and store, concurrent writers of one key do not share it
+    static auto storeCount = std::atomic<uint64_t>{};
+    auto temporary = m_directory / (name + '.' + std::to_string(processId()) + '.' + std::to_string(++storeCount));
+    {
+        auto out = std::ofstream{temporary, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out) return;
+    }
+    auto ec = std::error_code{};
+    fs::rename(temporary, m_directory / name, ec);
+    if (ec) return;
+
+    m_stats.stores++;
+    use(name, bytes.size());
+    evict();
+}
+
+auto CallCache::fullKey(const Bytes& key) const -> Bytes {
+    auto result = m_buildId;
+    result.insert(result.end(), key.begin(), key.end());
+    return result;
+}
+
+auto CallCache::stats() const -> CacheStats {
+    auto result = m_stats;
+    result.entries = m_entries.size();
+    result.bytes = m_bytes;
+    return result;
+}
+
+void CallCache::use(const std::string& name, uint64_t size) {
+    if (auto found = m_byName.find(name); found != m_byName.end()) remove(found->second);
+    m_entries.push_front(Entry{name, size});
+    m_byName[name] = m_entries.begin();
+    m_bytes += size;
+}
+
+void CallCache::remove(Entries::iterator it) {
+    m_bytes -= it->size;
+    m_byName.erase(it->name);
+    m_entries.erase(it);
+}
+
+void CallCache::evict() {
+    while (m_bytes > m_maxBytes && !m_entries.empty()) {
+        auto last = std::prev(m_entries.end());
+        auto ec = std::error_code{};
+        fs::remove(m_directory / last->name, ec);
+        remove(last);
+        m_stats.evictions++;
+    }
+}
+
+} // namespace cache
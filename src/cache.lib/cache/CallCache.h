@@ -0,0 +1,60 @@
+#pragma once
+#include <cinttypes>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cache {
+
+using Bytes = std::vector<uint8_t>;
+using Path = std::filesystem::path;
+
+/// counters of one compiler run
+struct CacheStats {
+    uint64_t hits{};
+    uint64_t misses{};
+    uint64_t stores{};
+    uint64_t evictions{};
+    uint64_t entries{}; ///< files in the cache directory
+    uint64_t bytes{}; ///< size of all files in the cache directory
+};
+
+/// results of compile time calls stored on disk, so they survive the compiler run
+// one file per key - the least recently used files are removed when the size limit is exceeded
+// not thread safe
+struct CallCache {
+    /// buildId identifies the compiler - entries stored by other builds are never loaded
+    CallCache(Path directory, uint64_t maxBytes, Bytes buildId = {});
+
+    /// stored value for the key or nullptr
+    // the bytes stay valid until the next load - callers keep a copy if loaded values point into them
+    [[nodiscard]] auto load(const Bytes& key) -> const Bytes*;
+    void store(const Bytes& key, const Bytes& value);
+
+    [[nodiscard]] auto stats() const -> CacheStats;
+
+private:
+    struct Entry {
+        std::string name{};
+        uint64_t size{};
+    };
+    using Entries = std::list<Entry>; // most recently used first
+
+    Path m_directory{};
+    uint64_t m_maxBytes{};
+    Bytes m_buildId{};
+    uint64_t m_bytes{};
+    Entries m_entries{};
+    std::unordered_map<std::string, Entries::iterator> m_byName{};
+    Bytes m_loaded{}; // value of the last load
+    CacheStats m_stats{};
+
+    auto fullKey(const Bytes& key) const -> Bytes;
+    void use(const std::string& name, uint64_t size);
+    void remove(Entries::iterator it);
+    void evict();
+};
+
+} // namespace cache
@@ -0,0 +1,15 @@
+#pragma once
+#include "CallCache.h"
+
+#include <ostream>
+
+namespace cache {
+
+inline auto operator<<(std::ostream& out, const CacheStats& stats) -> std::ostream& {
+    out << "call cache: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.stores << " stores, "
+        << stats.evictions << " evictions\n";
+    out << "            " << stats.entries << " entries, " << stats.bytes << " bytes\n";
+    return out;
+}
+
+} // namespace cache
@@ -0,0 +1,86 @@
+#include "CallCache.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+
+using namespace cache;
+
+namespace {
+
+struct TemporaryDirectory {
+    Path path;
+
+    explicit TemporaryDirectory(const char* name)
+        : path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(path);
+    }
+    ~TemporaryDirectory() { std::filesystem::remove_all(path); }
+};
+
+auto bytes(const char* text) -> Bytes { return Bytes{text, text + std::char_traits<char>::length(text)}; }
+
+} // namespace
+
+TEST(callCache, persists) {
+    auto dir = TemporaryDirectory{"rec_callCache_persists"};
+    {
+        auto cache = CallCache{dir.path, 1024};
+        EXPECT_EQ(cache.load(bytes("key")), nullptr);
+        cache.store(bytes("key"), bytes("value"));
+    }
+    auto cache = CallCache{dir.path, 1024};
+    const auto* value = cache.load(bytes("key"));
+
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, bytes("value"));
+    EXPECT_EQ(cache.load(bytes("other")), nullptr);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST(callCache, evictsLeastRecentlyUsed) {
+    auto dir = TemporaryDirectory{"rec_callCache_evicts"};
+    auto cache = CallCache{dir.path, 3 * 37}; // 12 bytes header, 1 byte key and 24 bytes value per entry
+
+    auto value = Bytes(24, 'v');
+    cache.store(bytes("a"), value);
+    cache.store(bytes("b"), value);
+    cache.store(bytes("c"), value);
+    ASSERT_NE(cache.load(bytes("a")), nullptr); // b is now least recently used
+    cache.store(bytes("d"), value);
+
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.load(bytes("b")), nullptr);
+    EXPECT_NE(cache.load(bytes("a")), nullptr);
+    EXPECT_NE(cache.load(bytes("c")), nullptr);
+    EXPECT_NE(cache.load(bytes("d")), nullptr);
+    EXPECT_EQ(cache.stats().bytes, 3u * 37u);
+}
+
+TEST(callCache, damagedFile) {
+    auto dir = TemporaryDirectory{"rec_callCache_damaged"};
+    auto cache = CallCache{dir.path, 1024};
+    cache.store(bytes("key"), bytes("value"));
+
+    for (const auto& file : std::filesystem::directory_iterator{dir.path}) {
+        std::ofstream{file.path(), std::ios::binary | std::ios::trunc} << "rcc";
+    }
+    EXPECT_EQ(cache.load(bytes("key")), nullptr);
+}
+
+TEST(callCache, otherBuild) {
+    auto dir = TemporaryDirectory{"rec_callCache_otherBuild"};
+    {
+        auto cache = CallCache{dir.path, 1024, bytes("build1")};
+        cache.store(bytes("key"), bytes("value"));
+    }
+    auto other = CallCache{dir.path, 1024, bytes("build2")};
+    EXPECT_EQ(other.load(bytes("key")), nullptr);
+
+    auto same = CallCache{dir.path, 1024, bytes("build1")};
+    EXPECT_NE(same.load(bytes("key")), nullptr);
+}
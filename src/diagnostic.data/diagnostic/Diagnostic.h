@@ -65,6 +65,7 @@ struct SourceCodeBlock : CodeBlock {
     String fileName; // - full path according to the platform
                      // - might be empty if input was given from console or string
     text::Line sourceLine{0}; // note: valid line numbers start with 1
+    strings::View source{}; // the lines in the loaded source - allows to find the file, not owned
 };
 
 struct Important {
@@ -0,0 +1,98 @@
+#include "DiagnosticQueue.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace diagnostic {
+
+namespace {
+
+std::atomic<uint64_t> nextQueueId{1};
+
+// buffer of the queue this thread pushed to last - saves the search in the common case
+struct CachedBuffer {
+    uint64_t queueId{};
+    void* buffer{};
+};
+thread_local auto cachedBuffer = CachedBuffer{};
+
+auto firstSourceBlock(const Diagnostic& diagnostic) -> const SourceCodeBlock* {
+    for (const auto& part : diagnostic.parts) {
+        if (!part.holds<Explanation>()) continue;
+        for (const auto& section : part.get<Explanation>().details) {
+            if (section.holds<SourceCodeBlock>()) return &section.get<SourceCodeBlock>();
+        }
+    }
+    return nullptr;
+}
+
+auto firstMarkerOffset(const SourceCodeBlock& block) -> int {
+    for (const auto& highlight : block.highlights) {
+        if (highlight.holds<Marker>()) return highlight.get<Marker>().span.start;
+    }
+    return 0;
+}
+
+} // namespace
+
+auto OrderKey::of(const Diagnostic& diagnostic, uint64_t sequence) -> OrderKey {
+    const auto* block = firstSourceBlock(diagnostic);
+    if (!block) return OrderKey{String{}, text::Line{0}, 0, sequence};
+    return OrderKey{block->fileName, block->sourceLine, firstMarkerOffset(*block), sequence};
+}
+
+bool OrderKey::operator<(const OrderKey& o) const {
+    auto fileView = [](const String& s) { return std::string_view{s.data(), s.byteCount().v}; };
+    return std::make_tuple(fileView(fileName), line.v, offset, sequence) <
+        std::make_tuple(fileView(o.fileName), o.line.v, o.offset, o.sequence);
+}
+
+DiagnosticQueue::DiagnosticQueue()
+    : m_id(nextQueueId.fetch_add(1, std::memory_order_relaxed)) {}
+
+DiagnosticQueue::~DiagnosticQueue() {
+    auto* buffer = m_buffers.load(std::memory_order_acquire);
+    while (buffer) delete std::exchange(buffer, buffer->next);
+}
+
+void DiagnosticQueue::push(Diagnostic diagnostic) {
+    auto sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+    auto key = OrderKey::of(diagnostic, sequence);
+    threadBuffer().entries.push_back(Entry{std::move(key), std::move(diagnostic)});
+}
+
+auto DiagnosticQueue::take() -> Diagnostics {
+    auto entries = std::vector<Entry>{};
+    for (auto* buffer = m_buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        std::move(buffer->entries.begin(), buffer->entries.end(), std::back_inserter(entries));
+        buffer->entries.clear();
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    auto result = Diagnostics{};
+    result.reserve(entries.size());
+    for (auto& entry : entries) result.push_back(std::move(entry.diagnostic));
+    return result;
+}
+
+auto DiagnosticQueue::threadBuffer() -> Buffer& {
+    if (cachedBuffer.queueId == m_id) return *static_cast<Buffer*>(cachedBuffer.buffer);
+
+    auto owner = std::this_thread::get_id();
+    auto* head = m_buffers.load(std::memory_order_acquire);
+    auto* buffer = head;
+    while (buffer && buffer->owner != owner) buffer = buffer->next;
+    if (!buffer) {
+        // only this thread adds a buffer for itself, so a failed exchange never requires a new search
+        buffer = new Buffer{owner};
+        buffer->next = head;
+        while (!m_buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release)) {}
+    }
+    cachedBuffer = CachedBuffer{m_id, buffer};
+    return *buffer;
+}
+
+} // namespace diagnostic
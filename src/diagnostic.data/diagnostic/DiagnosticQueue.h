@@ -0,0 +1,57 @@
+#pragma once
+#include "Diagnostic.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace diagnostic {
+
+/// where a diagnostic is reported - diagnostics are ordered by this key
+struct OrderKey {
+    String fileName{};
+    text::Line line{0}; // 0 = not located, ordered before all located diagnostics
+    int offset{}; // start of the first marker
+    uint64_t sequence{}; // order of reporting, keeps equal locations stable
+
+    [[nodiscard]] static auto of(const Diagnostic& diagnostic, uint64_t sequence) -> OrderKey;
+
+    [[nodiscard]] bool operator<(const OrderKey& o) const;
+};
+
+/// collects diagnostics reported by any thread without locking
+// every thread appends to its own buffer, take() merges them at a phase boundary
+struct DiagnosticQueue {
+    DiagnosticQueue();
+    ~DiagnosticQueue();
+
+    DiagnosticQueue(const DiagnosticQueue&) = delete;
+    DiagnosticQueue& operator=(const DiagnosticQueue&) = delete;
+
+    /// thread safe and lock free
+    void push(Diagnostic diagnostic);
+
+    /// all pushed diagnostics ordered by their OrderKey
+    // note: no push may run concurrently
+    [[nodiscard]] auto take() -> Diagnostics;
+
+private:
+    struct Entry {
+        OrderKey key;
+        Diagnostic diagnostic;
+    };
+    struct Buffer {
+        std::thread::id owner;
+        std::vector<Entry> entries{};
+        Buffer* next{};
+    };
+
+    auto threadBuffer() -> Buffer&;
+
+    uint64_t m_id; // identifies the queue in the thread local buffer cache
+    std::atomic<Buffer*> m_buffers{}; // only grows until destruction
+    std::atomic<uint64_t> m_sequence{};
+};
+
+} // namespace diagnostic
@@ -0,0 +1,53 @@
+#include "DiagnosticQueue.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+using namespace diagnostic;
+
+namespace {
+
+auto located(int line, int offset) -> Diagnostic {
+    auto highlights = Highlights{Marker{TextSpan{offset, 1}, String{}}};
+    auto block = SourceCodeBlock{CodeBlock{String{"code"}, highlights}, String{"file"}, text::Line{line}};
+    return Diagnostic{Code{String{"test"}, static_cast<uint32_t>(line * 100 + offset)},
+                      Parts{Explanation{String{"located"}, Document{block}}}};
+}
+
+auto numbers(const Diagnostics& diagnostics) -> std::vector<uint32_t> {
+    auto result = std::vector<uint32_t>{};
+    for (const auto& d : diagnostics) result.push_back(d.code.number);
+    return result;
+}
+
+} // namespace
+
+TEST(DiagnosticQueue, orderedByLocation) {
+    auto queue = DiagnosticQueue{};
+    queue.push(located(3, 1));
+    queue.push(located(1, 7));
+    queue.push(Diagnostic{Code{String{"test"}, 0}, {}});
+    queue.push(located(1, 2));
+
+    EXPECT_EQ(numbers(queue.take()), (std::vector<uint32_t>{0, 102, 107, 301}));
+    EXPECT_TRUE(queue.take().empty());
+}
+
+TEST(DiagnosticQueue, concurrentPush) {
+    auto queue = DiagnosticQueue{};
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 1; t <= 4; t++) {
+        threads.emplace_back([&queue, t] {
+            for (auto i = 0; i < 50; i++) queue.push(located(i + 1, t));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    auto diagnostics = queue.take();
+    ASSERT_EQ(diagnostics.size(), 200u);
+    auto expected = std::vector<uint32_t>{};
+    for (auto i = 0; i < 50; i++)
+        for (auto t = 1; t <= 4; t++) expected.push_back(static_cast<uint32_t>((i + 1) * 100 + t));
+    EXPECT_EQ(numbers(diagnostics), expected);
+}
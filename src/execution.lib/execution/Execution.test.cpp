@@ -12,7 +12,13 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace expression = parser;
 namespace block = nesting;
@@ -94,3 +100,190 @@ INSTANTIATE_TEST_CASE_P(
                     .rawIntrinsic(&ExecutionMachineData::literal))
             .run(parser::call("print").right(parser::arg("v", parser::valueExpr(nesting::num("42")).typeName("Lit"))))
             .expect("42")));
+
+namespace {
+
+std::mutex recordMutex;
+std::vector<std::string> records;
+
+void record(uint8_t* memory, intrinsic::ContextInterface*) {
+    auto& lit = *reinterpret_cast<parser::NumberLiteral*>(memory);
+    auto lock = std::lock_guard{recordMutex};
+    records.emplace_back(static_cast<std::string>(strings::String{lit.value.integerPart}));
+}
+
+auto indexOf(const char* value) -> size_t {
+    return static_cast<size_t>(std::find(records.begin(), records.end(), value) - records.begin());
+}
+
+} // namespace
+
+// independent calls run on the task pool, calls with side effects keep their order
+TEST(MachineTests, concurrentCalls) {
+    auto scope = std::make_shared<instance::Scope>();
+    instance::buildScope(
+        *scope,
+        instance::typeModT<nesting::NumberLiteral>("Lit"),
+        instance::fun("pure").params(instance::param("v").right().type(parser::type("Lit"))).rawIntrinsic(&record),
+        instance::fun("effect")
+            .compiletime_sideeffects()
+            .params(instance::param("v").right().type(parser::type("Lit")))
+            .rawIntrinsic(&record));
+
+    auto callOf = [&]<size_t N, size_t M>(const char(&name)[N], const char(&num)[M]) {
+        return parser::call(name)
+            .right(parser::arg("v", parser::valueExpr(nesting::num(num)).typeName("Lit")))
+            .build(*scope);
+    };
+    auto block = parser::Block{};
+    block.expressions.emplace_back(callOf("effect", "1"));
+    block.expressions.emplace_back(callOf("pure", "2"));
+    block.expressions.emplace_back(callOf("pure", "3"));
+    block.expressions.emplace_back(callOf("effect", "4"));
+    block.expressions.emplace_back(callOf("pure", "5"));
+    block.expressions.emplace_back(callOf("pure", "6"));
+
+    auto pool = execution::TaskPool{4};
+    auto compiler = execution::Compiler{};
+    compiler.taskPool = &pool;
+    compiler.minConcurrentWork = 0; // every run is dispatched
+    auto context = execution::Context{};
+    context.compiler = &compiler;
+
+    records.clear();
+    execution::Machine::runBlock(block, context);
+
+    ASSERT_EQ(records.size(), 6u);
+    EXPECT_EQ(indexOf("1"), 0u);
+    EXPECT_EQ(indexOf("4"), 3u);
+    EXPECT_LT(indexOf("2"), 3u);
+    EXPECT_LT(indexOf("3"), 3u);
+    EXPECT_GT(indexOf("5"), 3u);
+    EXPECT_GT(indexOf("6"), 3u);
+}
+
+namespace {
+
+void say(uint8_t* memory, intrinsic::ContextInterface* context) {
+    auto& lit = *reinterpret_cast<parser::NumberLiteral*>(memory);
+    auto text = strings::to_string(lit.value.integerPart);
+    context->output(strings::View{text});
+    context->output(strings::View{";"});
+}
+
+} // namespace
+
+// output of concurrent calls is merged in the order of the calls
+TEST(MachineTests, concurrentOutput) {
+    auto scope = std::make_shared<instance::Scope>();
+    instance::buildScope(
+        *scope,
+        instance::typeModT<nesting::NumberLiteral>("Lit"),
+        instance::fun("say").params(instance::param("v").right().type(parser::type("Lit"))).rawIntrinsic(&say));
+
+    auto block = parser::Block{};
+    auto addSay = [&]<size_t N>(const char(&num)[N]) {
+        auto value = parser::valueExpr(nesting::num(num)).typeName("Lit");
+        block.expressions.emplace_back(parser::call("say").right(parser::arg("v", value)).build(*scope));
+    };
+    addSay("1");
+    addSay("2");
+    addSay("3");
+    addSay("4");
+    addSay("5");
+    addSay("6");
+
+    auto out = std::stringstream{};
+    auto pool = execution::TaskPool{4};
+    auto output = execution::OutputBuffer{&out, 4};
+    auto compiler = execution::Compiler{};
+    compiler.taskPool = &pool;
+    compiler.minConcurrentWork = 0;
+    compiler.output = &output;
+    auto context = execution::Context{};
+    context.compiler = &compiler;
+
+    execution::Machine::runBlock(block, context);
+    output.flush();
+
+    EXPECT_EQ(out.str(), "1;2;3;4;5;6;");
+}
+
+namespace {
+
+std::vector<std::thread::id> threadIds;
+
+void recordThread(uint8_t*, intrinsic::ContextInterface*) {
+    auto lock = std::lock_guard{recordMutex};
+    threadIds.push_back(std::this_thread::get_id());
+}
+
+} // namespace
+
+// runs with less estimated work than the threshold are not dispatched
+TEST(MachineTests, smallRunsStaySerial) {
+    auto scope = std::make_shared<instance::Scope>();
+    instance::buildScope(*scope, instance::fun("pure").rawIntrinsic(&recordThread));
+
+    auto block = parser::Block{};
+    for (auto i = 0; i < 4; i++) block.expressions.emplace_back(parser::call("pure").build(*scope));
+
+    auto pool = execution::TaskPool{4};
+    auto compiler = execution::Compiler{};
+    compiler.taskPool = &pool;
+    compiler.minConcurrentWork = 5;
+    auto context = execution::Context{};
+    context.compiler = &compiler;
+
+    threadIds.clear();
+    execution::Machine::runBlock(block, context);
+    ASSERT_EQ(threadIds.size(), 4u);
+    for (auto id : threadIds) EXPECT_EQ(id, std::this_thread::get_id());
+
+    const auto& function = *block.expressions.front().get<parser::Call>().function;
+    EXPECT_NE(function.callProfile.load(), 0u); // analysed once, later runs reuse it
+}
+
+namespace {
+
+void makeSeven(uint8_t* memory, intrinsic::ContextInterface*) {
+    auto& result = **reinterpret_cast<parser::NumberLiteral**>(memory);
+    result = nesting::num("7");
+}
+
+void printReference(uint8_t* memory, intrinsic::ContextInterface*) {
+    const auto& lit = **reinterpret_cast<const parser::NumberLiteral**>(memory);
+    records.emplace_back(static_cast<std::string>(strings::String{lit.value.integerPart}));
+}
+
+} // namespace
+
+// call results and missing values are materialised for reference parameters
+TEST(MachineTests, referenceTemporaries) {
+    auto scope = std::make_shared<instance::Scope>();
+    instance::buildScope(
+        *scope,
+        instance::typeModT<nesting::NumberLiteral>("Lit"),
+        instance::fun("make").params(instance::param("r").result().type(parser::type("Lit"))).rawIntrinsic(&makeSeven),
+        instance::fun("print")
+            .params(instance::param("v").right().reference().type(parser::type("Lit")))
+            .rawIntrinsic(&printReference));
+
+    auto compiler = execution::Compiler{};
+    auto context = execution::Context{};
+    context.compiler = &compiler;
+
+    records.clear();
+    auto call = parser::call("print").right(parser::arg("v", parser::valueExpr(parser::call("make")))).build(*scope);
+    execution::Machine::runCall(call, context);
+
+    auto ntv = parser::NameTypeValue{}; // declared without a value
+    auto missing = parser::call("print").build(*scope);
+    missing.arguments.push_back(parser::ArgumentAssignment{
+        call.arguments.front().parameter, {parser::ValueExpr{parser::NameTypeValueReference{&ntv}}}});
+    execution::Machine::runCall(missing, context);
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0], "7");
+    EXPECT_EQ(records[1], ""); // default value
+}
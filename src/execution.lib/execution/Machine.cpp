@@ -2,6 +2,7 @@
 
 namespace execution {
 
-// empty
+const meta::EventCounter runCalls{"Machine.runCall"};
+const meta::EventCounter parseReentries{"IntrinsicContext.parse"};
 
 } // namespace execution
@@ -1,6 +1,8 @@
 #pragma once
 #include "execution/Frame.h"
+#include "execution/OutputBuffer.h"
 #include "execution/Stack.h"
+#include "execution/TaskPool.h"
 
 #include "parser/Expression.h"
 
@@ -9,8 +11,11 @@
 #include "instance/Scope.h"
 #include "instance/Variable.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
+#include <set>
+#include <vector>
 
 namespace execution {
 
@@ -18,13 +23,20 @@ namespace execution {
 // TODO(arBmind): run destructors on frames!
 // TODO(arBmind): assign defaults to results if unused!
 
-using ParseBlock = std::function<parser::Block(const nesting::BlockLiteral& block, const instance::ScopePtr& scope)>;
+extern const meta::EventCounter runCalls; ///< calls of Machine::runCall
+extern const meta::EventCounter parseReentries; ///< blocks parsed from intrinsics during execution
+
+using ParseBlock = intrinsic::ParseBlock;
 using ReportDiagnositc = std::function<void(diagnostic::Diagnostic)>;
 
 struct Compiler {
     Stack stack{}; // stack allocator
     ParseBlock parseBlock{};
     ReportDiagnositc reportDiagnostic = [](diagnostic::Diagnostic) {};
+    TaskPool* taskPool{}; ///< opt-in: runs independent calls of a block concurrently
+    size_t minConcurrentWork{64}; ///< runs with fewer estimated calls are not worth dispatching to the pool
+    bool lazyModules{}; ///< opt-in: declared module bodies are parsed on the first member lookup
+    OutputBuffer* output{}; ///< compile time output (Rebuild.say) - nullptr discards it
 };
 
 struct Context {
@@ -36,6 +48,7 @@ struct Context {
 
     Byte* localBase{};
     LocalFrame localFrame{};
+    std::vector<parser::Value> temporaries{}; ///< arguments materialised for reference parameters
 
     auto byVariable(instance::VariableView var) const& -> Byte* {
         auto addr = localFrame.byVariable(var);
@@ -68,14 +81,24 @@ struct IntrinsicContext : intrinsic::ContextInterface {
         , compiler(context.compiler) {}
 
     auto parse(const parser::BlockLiteral& block, const instance::ScopePtr& scope) const -> parser::Block override {
+        parseReentries.add();
         return compiler->parseBlock(block, scope);
     }
 
+    auto lazyModuleParser() const -> ParseBlock override {
+        return compiler->lazyModules ? compiler->parseBlock : ParseBlock{};
+    }
+
     void report(diagnostic::Diagnostic diagnostic) override { compiler->reportDiagnostic(std::move(diagnostic)); }
+
+    void output(strings::View text) override {
+        if (compiler->output) compiler->output->write(text);
+    }
 };
 
 struct Machine {
     static void runCall(const parser::Call& call, const Context& context) {
+        runCalls.add();
         auto tmpContext = storeTemporaryResults(call, context);
         auto callContext = storeArguments(call, tmpContext);
 
@@ -87,6 +110,14 @@ struct Machine {
         runFunctionBlock(block, blockContext);
     }
 
+    /// true if the result of the call only depends on its argument values
+    // no compile time side effects and no variables are involved
+    static bool isPure(const parser::Call& call) {
+        auto access = VariableAccess{};
+        auto visiting = Visiting{};
+        return collectAccess(call, access, visiting) && access.reads.empty() && access.writes.empty();
+    }
+
 private:
     static void runBlockExpr(const parser::BlockExpr& expr, Context& context) {
         expr.visit(
@@ -120,11 +151,191 @@ private:
         nested.localBase = frameData.get();
         layoutVariables(block.expressions, nested);
 
-        for (const auto& node : block.expressions) {
-            runBlockExpr(node, nested);
+        const auto& nodes = block.expressions;
+        for (auto i = size_t{}; i < nodes.size();) {
+            auto run = context.compiler->taskPool ? independentRun(nodes, i) : IndependentRun{i};
+            if (run.end - i > 1 && run.work >= context.compiler->minConcurrentWork) {
+                runConcurrent(nodes, i, run.end, nested);
+                i = run.end;
+                continue;
+            }
+            // small runs are executed serially as a whole, so they are not analysed again
+            for (auto end = std::max(run.end, i + 1); i < end; i++) runBlockExpr(nodes[i], nested);
         }
     }
 
+    // runs calls [begin, end) on the task pool - each task gets its own stack
+    // diagnostics and output are replayed in order, so the result is the same as for serial execution
+    static void runConcurrent(const parser::VecOfBlockExpr& nodes, size_t begin, size_t end, Context& context) {
+        auto count = end - begin;
+        auto reports = std::vector<std::vector<diagnostic::Diagnostic>>(count);
+        auto outputs = std::vector<OutputBuffer>(count);
+        auto tasks = TaskPool::Tasks{};
+        tasks.reserve(count);
+        for (auto i = size_t{}; i < count; i++) {
+            tasks.emplace_back([&, i] {
+                auto compiler = Compiler{Stack{Stack::defaultSize}, context.compiler->parseBlock};
+                compiler.reportDiagnostic = [&](diagnostic::Diagnostic d) { reports[i].push_back(std::move(d)); };
+                if (context.compiler->output) compiler.output = &outputs[i];
+                auto taskContext = context.createNested();
+                taskContext.compiler = &compiler;
+                runCall(nodes[begin + i].get<parser::Call>(), taskContext);
+            });
+        }
+        context.compiler->taskPool->runAll(tasks);
+        for (auto& taskReports : reports)
+            for (auto& d : taskReports) context.compiler->reportDiagnostic(std::move(d));
+        if (context.compiler->output)
+            for (auto& taskOutput : outputs) context.compiler->output->merge(taskOutput);
+    }
+
+    /// variables a call reads and writes through its arguments
+    struct VariableAccess {
+        std::set<instance::VariableView> reads{};
+        std::set<instance::VariableView> writes{};
+        size_t work{}; ///< estimated number of calls executed
+
+        static bool intersects(const std::set<instance::VariableView>& a, const std::set<instance::VariableView>& b) {
+            for (auto v : a)
+                if (b.count(v) != 0) return true;
+            return false;
+        }
+        bool conflicts(const VariableAccess& o) const {
+            return intersects(writes, o.writes) || intersects(writes, o.reads) || intersects(reads, o.writes);
+        }
+        void merge(const VariableAccess& o) {
+            reads.insert(o.reads.begin(), o.reads.end());
+            writes.insert(o.writes.begin(), o.writes.end());
+            work += o.work;
+        }
+    };
+
+    struct IndependentRun {
+        size_t end{};
+        size_t work{}; ///< estimated number of calls of the whole run
+    };
+
+    // run of calls starting at begin that are free of side effects and use disjoint variables
+    static auto independentRun(const parser::VecOfBlockExpr& nodes, size_t begin) -> IndependentRun {
+        auto runAccess = VariableAccess{};
+        auto end = begin;
+        auto visiting = Visiting{};
+        for (; end < nodes.size(); end++) {
+            if (!nodes[end].holds<parser::Call>()) break;
+            auto access = VariableAccess{};
+            if (!collectAccess(nodes[end].get<parser::Call>(), access, visiting)) break;
+            if (runAccess.conflicts(access)) break;
+            runAccess.merge(access);
+        }
+        return {end, runAccess.work};
+    }
+
+    using Visiting = std::vector<instance::FunctionView>; ///< functions whose analysis is in progress
+
+    static bool collectAccess(const parser::Call& call, VariableAccess& access, Visiting& visiting) {
+        auto profile = profileOf(*call.function, visiting);
+        if (!profile.isIndependent) return false;
+        access.work += profile.work;
+        for (const auto& assign : call.arguments) {
+            const auto& param = *assign.parameter;
+            auto writes = param.side == instance::ParameterSide::result ||
+                param.flags.any(instance::ParameterFlag::assignable);
+            for (const auto& value : assign.values) {
+                if (!collectValueAccess(value, writes, access, visiting)) return false;
+            }
+        }
+        return true;
+    }
+
+    static bool
+    collectValueAccess(const parser::ValueExpr& expr, bool writes, VariableAccess& access, Visiting& visiting) {
+        return expr.visit(
+            [&](const parser::Call& call) { return collectAccess(call, access, visiting); },
+            [&](const parser::VariableReference& var) {
+                (writes ? access.writes : access.reads).insert(var.variable);
+                return true;
+            },
+            [&](const parser::NameTypeValueReference& ref) {
+                if (!ref.nameTypeValue || !ref.nameTypeValue->value) return true;
+                return collectValueAccess(ref.nameTypeValue->value.value(), writes, access, visiting);
+            },
+            [&](const parser::NameTypeValueTuple& tuple) {
+                for (const auto& entry : *tuple.tuple) {
+                    if (entry.value && !collectValueAccess(entry.value.value(), writes, access, visiting)) return false;
+                }
+                return true;
+            },
+            [&](const parser::Value&) { return true; },
+            [&](const parser::TypeReference&) { return true; },
+            [&](const parser::ModuleReference&) { return true; },
+            [&](const auto&) { return false; }); // blocks and partially parsed
+    }
+
+    struct CallProfile {
+        bool isIndependent{};
+        size_t work{}; ///< estimated number of calls executed by one call - saturates at maxWork
+
+        static constexpr auto maxWork = size_t{(1u << 30u) - 1};
+        static constexpr auto computedBit = uint32_t{1};
+        static constexpr auto independentBit = uint32_t{2};
+
+        auto pack() const -> uint32_t {
+            return computedBit | (isIndependent ? independentBit : 0) | static_cast<uint32_t>(work << 2u);
+        }
+        static auto unpack(uint32_t packed) -> CallProfile {
+            return {(packed & independentBit) != 0, packed >> 2u};
+        }
+    };
+
+    // the profile is computed once per function, bodies are complete once they are executed
+    // recursion is never independent - so a result that met a function in progress is final as well
+    static auto profileOf(const instance::Function& function, Visiting& visiting) -> CallProfile {
+        auto packed = function.callProfile.load(std::memory_order_acquire);
+        if (packed != 0) return CallProfile::unpack(packed);
+        if (meta::findIf(visiting, [&](auto f) { return f == &function; }) != visiting.end()) return {};
+
+        visiting.push_back(&function);
+        auto profile = analyseFunction(function, visiting);
+        visiting.pop_back();
+        profile.work = std::min(profile.work, CallProfile::maxWork);
+        function.callProfile.store(profile.pack(), std::memory_order_release);
+        return profile;
+    }
+
+    // a function is independent if it has no compile time side effects
+    // parsed bodies may only touch their own parameters and locals
+    static auto analyseFunction(const instance::Function& function, Visiting& visiting) -> CallProfile {
+        if (function.flags.any(instance::FunctionFlag::compile_time_side_effects)) return {};
+        return function.body.visit(
+            [](const instance::IntrinsicCall&) { return CallProfile{true, 1}; },
+            [&](const instance::ParsedBlock& parsed) -> CallProfile {
+                auto owned = std::set<instance::VariableView>{};
+                for (const auto& param : function.parameters) owned.insert(param->variable);
+                for (const auto& node : parsed.block.expressions) {
+                    node.visitSome([&](const parser::VariableInit& init) { owned.insert(init.variable); });
+                }
+                auto access = VariableAccess{};
+                for (const auto& node : parsed.block.expressions) {
+                    auto isLocal = node.visit(
+                        [&](const parser::Call& call) { return collectAccess(call, access, visiting); },
+                        [&](const parser::VariableInit& init) {
+                            for (const auto& value : init.nodes) {
+                                if (!collectValueAccess(value, false, access, visiting)) return false;
+                            }
+                            return true;
+                        },
+                        [&](const parser::Value&) { return true; },
+                        [&](const parser::VariableReference&) { return true; },
+                        [&](const auto&) { return false; });
+                    if (!isLocal) return {};
+                }
+                auto isOwned = [&](instance::VariableView v) { return owned.count(v) != 0; };
+                auto isIndependent = std::all_of(access.reads.begin(), access.reads.end(), isOwned) &&
+                    std::all_of(access.writes.begin(), access.writes.end(), isOwned);
+                return {isIndependent, 1 + access.work};
+            });
+    }
+
     static void runIntrinsic(const instance::IntrinsicCall& intrinsic, Context& context) {
         Byte* memory = context.localBase; // arguments
         auto intrinsicContext = IntrinsicContext{context, nullptr};
@@ -138,7 +349,7 @@ private:
     }
 
     static void runTuple(const parser::NameTypeValueTuple& ntvTuple, Context& context) {
-        for (const auto& entry : ntvTuple.tuple) {
+        for (const auto& entry : *ntvTuple.tuple) {
             runValueExpr(entry.value.value(), context);
         }
     }
@@ -177,7 +388,7 @@ private:
         if (param->flags.any(ParameterFlag::splatted)) {
             return 8; // TODO(arBmind): sizeof(Array)
         }
-        if (param->flags.any(ParameterFlag::assignable)) {
+        if (param->flags.any(ParameterFlag::assignable, ParameterFlag::reference)) {
             return sizeof(void*); // passed as pointer
         }
         if (param->variable->type) {
@@ -245,10 +456,10 @@ private:
         Byte* memory) {
 
         if (auto* assign = findAssign(call.arguments, parameter); assign != nullptr) {
-            storeArgument(*context.caller, memory, parameter, assign->values);
+            storeArgument(*context.caller, memory, parameter, assign->values, context.temporaries);
         }
         else if (!parameter.defaultValue.empty()) {
-            storeArgument(*context.caller, memory, parameter, parameter.defaultValue);
+            storeArgument(*context.caller, memory, parameter, parameter.defaultValue, context.temporaries);
         }
         else if (parameter.side == instance::ParameterSide::result) {
             auto tmpMemory = context.caller->byVariable(parameter.variable);
@@ -294,7 +505,8 @@ private:
         const Context& context, //
         Byte* memory,
         const instance::Parameter& param,
-        const parser::VecOfValueExpr& nodes) {
+        const parser::VecOfValueExpr& nodes,
+        std::vector<parser::Value>& temporaries) {
 
         using namespace instance;
         if (param.flags.any(ParameterFlag::splatted)) {
@@ -309,6 +521,11 @@ private:
                 [&](const auto&) { assert(false); });
             return;
         }
+        if (param.flags.any(ParameterFlag::reference)) {
+            assert(nodes.size() == 1);
+            storeReference(nodes[0], param, context, memory, temporaries);
+            return;
+        }
         for (const auto& node : nodes) {
             storeValueExpr(node, context, memory);
         }
@@ -338,6 +555,39 @@ private:
             [](const parser::VecOfPartiallyParsed&) {});
     }
 
+    // values are immutable, so we can pass the address instead of a copy
+    // everything else is materialised into a temporary that lives as long as the call
+    static void storeReference(
+        const parser::ValueExpr& node,
+        const instance::Parameter& param,
+        const Context& context,
+        Byte* memory,
+        std::vector<parser::Value>& temporaries) {
+
+        auto& type = param.variable->type;
+        node.visit(
+            [&](const parser::VariableReference& var) { storeVariableAddress(*var.variable, context, memory); },
+            [&](const parser::NameTypeValueReference& ref) {
+                if (ref.nameTypeValue && ref.nameTypeValue->value)
+                    storeReference(ref.nameTypeValue->value.value(), param, context, memory, temporaries);
+                else
+                    storeValueAddress(temporaries.emplace_back(type), memory); // default value
+            },
+            [&](const parser::Value& value) { storeValueAddress(value, memory); },
+            [&](const parser::Call& call) {
+                auto& result = temporaries.emplace_back(type);
+                storeCallResult(call, context, static_cast<Byte*>(result.data()));
+                storeValueAddress(result, memory);
+            },
+            [&](const parser::NameTypeValueTuple& tuple) {
+                auto& copy = temporaries.emplace_back(type);
+                copy.set<parser::NameTypeValueTuple>() = tuple;
+                storeValueAddress(copy, memory);
+            },
+            // not values - a default keeps the intrinsic well defined
+            [&](const auto&) { storeValueAddress(temporaries.emplace_back(type), memory); });
+    }
+
     static void storeCallResult(const parser::Call& call, const Context& context, Byte* memory) {
         auto stackSize = argumentsSize(*call.function);
         auto stackData = context.compiler->stack.allocate(stackSize);
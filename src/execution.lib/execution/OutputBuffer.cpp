@@ -0,0 +1,41 @@
+#include "OutputBuffer.h"
+
+namespace execution {
+
+OutputBuffer::OutputBuffer(std::ostream* target, size_t capacity)
+    : m_target(target)
+    , m_capacity(capacity) {
+    if (m_target) m_buffer.reserve(m_capacity);
+}
+
+OutputBuffer::~OutputBuffer() { flush(); }
+
+void OutputBuffer::write(strings::View text) {
+    m_buffer.append(text.data(), text.size());
+    flushIfFull();
+}
+
+void OutputBuffer::write(char chr) {
+    m_buffer.push_back(chr);
+    flushIfFull();
+}
+
+void OutputBuffer::merge(OutputBuffer& other) {
+    write(other.buffered());
+    other.m_buffer.clear();
+}
+
+void OutputBuffer::flush() {
+    if (!m_target || m_buffer.empty()) return;
+    m_target->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_target->flush();
+    m_buffer.clear();
+}
+
+auto OutputBuffer::buffered() const -> strings::View { return strings::View{m_buffer}; }
+
+void OutputBuffer::flushIfFull() {
+    if (m_buffer.size() >= m_capacity) flush();
+}
+
+} // namespace execution
@@ -0,0 +1,40 @@
+#pragma once
+#include "strings/View.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace execution {
+
+/// collects compile time output and writes it to the target in large chunks
+// without a target everything is kept until it is merged into another buffer
+struct OutputBuffer {
+    static constexpr auto defaultCapacity = size_t{64} << 10u;
+
+    explicit OutputBuffer(std::ostream* target = nullptr, size_t capacity = defaultCapacity);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void write(strings::View text);
+    void write(char chr);
+
+    /// appends all output kept by other
+    void merge(OutputBuffer& other);
+
+    /// writes the buffered output to the target
+    void flush();
+
+    [[nodiscard]] auto buffered() const -> strings::View;
+
+private:
+    void flushIfFull();
+
+    std::ostream* m_target{};
+    size_t m_capacity{};
+    std::string m_buffer{};
+};
+
+} // namespace execution
@@ -4,6 +4,8 @@
 
 namespace execution {
 
+const meta::EventCounter stackBytes{"Stack.bytes"};
+
 Stack::Stack(size_t total)
     : data(new Byte[total])
     , total{total}
@@ -11,6 +13,7 @@ Stack::Stack(size_t total)
 
 auto Stack::allocate(size_t size) -> Ptr {
     if (size > 0 && used + size < total) {
+        stackBytes.add(size);
         auto p = data.get() + used;
         used += size;
         return Ptr{p, StackDeleter{this, size}};
@@ -1,4 +1,6 @@
 #pragma once
+#include "meta/EventCounter.h"
+
 #include <cinttypes>
 #include <memory>
 
@@ -6,11 +8,15 @@ namespace execution {
 
 using Byte = uint8_t;
 
+extern const meta::EventCounter stackBytes; ///< bytes handed out by Stack::allocate
+
 /**
  * initially allocated once never invalidates pointers!
  */
 struct Stack {
-    Stack(size_t total = 1024 * 1024);
+    static constexpr auto defaultSize = size_t{1024 * 1024}; ///< used by serial execution and every task
+
+    Stack(size_t total = defaultSize);
 
     struct StackDeleter {
         Stack* stack;
@@ -0,0 +1,52 @@
+#include "TaskPool.h"
+
+namespace execution {
+
+TaskPool::TaskPool(size_t threads) {
+    for (auto i = size_t{1}; i < threads; i++) m_workers.emplace_back([this] { work(); });
+}
+
+TaskPool::~TaskPool() {
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+}
+
+void TaskPool::runAll(Tasks& tasks) {
+    if (tasks.empty()) return;
+    auto batch = std::lock_guard{m_batchMutex};
+    auto lock = std::unique_lock{m_mutex};
+    m_tasks = &tasks;
+    m_next = 0;
+    m_pending = tasks.size();
+    m_wake.notify_all();
+
+    while (runNext(lock)) {}
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_tasks = nullptr;
+}
+
+void TaskPool::work() {
+    auto lock = std::unique_lock{m_mutex};
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stop || (m_tasks && m_next < m_tasks->size()); });
+        if (m_stop) return;
+        while (runNext(lock)) {}
+    }
+}
+
+// note: lock is released while the task runs
+bool TaskPool::runNext(std::unique_lock<std::mutex>& lock) {
+    if (!m_tasks || m_next >= m_tasks->size()) return false;
+    auto& task = (*m_tasks)[m_next++];
+    lock.unlock();
+    task();
+    lock.lock();
+    if (--m_pending == 0) m_done.notify_all();
+    return true;
+}
+
+} // namespace execution
@@ -0,0 +1,43 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace execution {
+
+/// fixed set of worker threads that run batches of independent tasks
+struct TaskPool {
+    using Task = std::function<void()>;
+    using Tasks = std::vector<Task>;
+
+    explicit TaskPool(size_t threads = std::thread::hardware_concurrency());
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /// runs all tasks and returns when every task has finished
+    // the calling thread takes part, only one batch runs at a time
+    void runAll(Tasks& tasks);
+
+    [[nodiscard]] auto threadCount() const -> size_t { return m_workers.size() + 1; }
+
+private:
+    void work();
+    bool runNext(std::unique_lock<std::mutex>& lock);
+
+    std::vector<std::thread> m_workers{};
+    std::mutex m_mutex{};
+    std::condition_variable m_wake{};
+    std::condition_variable m_done{};
+    std::mutex m_batchMutex{}; // serializes runAll calls
+    Tasks* m_tasks{};
+    size_t m_next{};
+    size_t m_pending{};
+    bool m_stop{};
+};
+
+} // namespace execution
@@ -0,0 +1,69 @@
+#include "Budget.h"
+
+#include <cstdlib>
+#include <new>
+
+// counts all allocations of the process by replacing the global operator new
+// note: only link this into executables without sanitizers - they bring their own allocator (see Budget.cpp)
+
+namespace {
+
+auto allocate(size_t size) noexcept -> void* {
+    fuzz::countAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+auto allocate(size_t size, std::align_val_t alignment) noexcept -> void* {
+    fuzz::countAllocation(size);
+    auto align = static_cast<size_t>(alignment);
+    auto rounded = (size + align - 1) / align * align; // aligned_alloc requires a multiple of the alignment
+#ifdef _WIN32
+    return _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+    return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+}
+
+void release(void* p) noexcept { std::free(p); }
+
+void releaseAligned(void* p) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+template<class... Args>
+auto allocateOrThrow(size_t size, Args... args) -> void* {
+    if (auto* p = allocate(size, args...)) return p;
+    throw std::bad_alloc{};
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocateOrThrow(size); }
+void* operator new[](size_t size) { return allocateOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateOrThrow(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateOrThrow(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, size_t) noexcept { release(p); }
+void operator delete[](void* p, size_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(p); }
@@ -0,0 +1,39 @@
+#include "Budget.h"
+
+#include <atomic>
+
+#if defined(__SANITIZE_ADDRESS__)
+#    define FUZZ_SANITIZER_HOOKS
+#elif defined(__has_feature)
+#    if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#        define FUZZ_SANITIZER_HOOKS
+#    endif
+#endif
+
+#ifdef FUZZ_SANITIZER_HOOKS
+// from <sanitizer/allocator_interface.h> - not every toolchain ships the header
+extern "C" int __sanitizer_install_malloc_and_free_hooks(
+    void (*mallocHook)(const volatile void*, size_t), void (*freeHook)(const volatile void*));
+#endif
+
+namespace fuzz {
+
+namespace {
+
+std::atomic<uint64_t> g_allocatedBytes{};
+
+#ifdef FUZZ_SANITIZER_HOOKS
+// the sanitizer owns the allocator - we only observe it, so its heap checks stay active
+void mallocHook(const volatile void*, size_t size) { countAllocation(size); }
+void freeHook(const volatile void*) {}
+
+[[maybe_unused]] const auto g_hooksInstalled = __sanitizer_install_malloc_and_free_hooks(&mallocHook, &freeHook);
+#endif
+
+} // namespace
+
+auto allocatedBytes() -> uint64_t { return g_allocatedBytes.load(std::memory_order_relaxed); }
+
+void countAllocation(size_t size) { g_allocatedBytes.fetch_add(size, std::memory_order_relaxed); }
+
+} // namespace fuzz
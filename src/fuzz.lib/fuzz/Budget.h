@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+
+namespace fuzz {
+
+using Clock = std::chrono::steady_clock;
+
+/// allowed resources for processing an input
+// everything scales linear with the input size - super linear behavior exceeds the budget
+struct Budget {
+    Clock::duration baseTime{};
+    Clock::duration timePerByte{};
+    uint64_t baseBytes{}; ///< allocated heap bytes
+    uint64_t bytesPerByte{};
+
+    [[nodiscard]] auto timeFor(size_t size) const -> Clock::duration {
+        return baseTime + timePerByte * static_cast<int64_t>(size);
+    }
+    [[nodiscard]] auto bytesFor(size_t size) const -> uint64_t { return baseBytes + bytesPerByte * size; }
+};
+
+/// resources used by one run
+struct Usage {
+    Clock::duration time{};
+    uint64_t allocatedBytes{};
+};
+
+/// total of heap bytes allocated so far
+// counts only if a counter is active - see AllocationCounter.cpp
+auto allocatedBytes() -> uint64_t;
+/// adds an allocation to the total (called by the allocation counter)
+void countAllocation(size_t size);
+
+template<class F>
+auto measureUsage(F&& f) -> Usage {
+    auto startBytes = allocatedBytes();
+    auto start = Clock::now();
+    f();
+    return {Clock::now() - start, allocatedBytes() - startBytes};
+}
+
+/// deterministic part of the budget - allocated bytes only depend on the input
+inline bool isWithinAllocations(const Budget& budget, size_t size, const Usage& usage) {
+    return usage.allocatedBytes <= budget.bytesFor(size);
+}
+
+/// also checks the wall time - too noisy for test runs on shared machines, only the fuzz driver uses it
+inline bool isWithin(const Budget& budget, size_t size, const Usage& usage) {
+    return usage.time <= budget.timeFor(size) && isWithinAllocations(budget, size, usage);
+}
+
+} // namespace fuzz
@@ -0,0 +1,59 @@
+#include "Stages.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+auto readFile(const fs::path& path) -> std::string {
+    auto file = std::ifstream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+// the environment overrides the build - without both the corpus next to this file is used
+auto corpusDir() -> fs::path {
+    if (const auto* env = std::getenv("FUZZ_CORPUS_DIR")) return env;
+#ifdef FUZZ_CORPUS_DIR
+    return FUZZ_CORPUS_DIR;
+#else
+    return fs::path{__FILE__}.parent_path() / "corpus";
+#endif
+}
+
+} // namespace
+
+TEST(fuzzRegression, countsAllocations) {
+    volatile auto size = size_t{64};
+    auto usage = fuzz::measureUsage([&] {
+        auto bytes = std::vector<char>(size);
+        ASSERT_NE(bytes.data(), nullptr);
+    });
+    EXPECT_GE(usage.allocatedBytes, 64u);
+}
+
+// every corpus input has to stay within the allocation budget of its stage
+// wall time is only checked by the fuzz driver - it is not deterministic
+TEST(fuzzRegression, corpus) {
+    auto count = 0;
+    for (auto stage : fuzz::allStages) {
+        auto dir = corpusDir() / fuzz::stageName(stage);
+        if (!fs::exists(dir)) continue;
+        for (const auto& entry : fs::directory_iterator{dir}) {
+            auto content = readFile(entry.path());
+            auto input = strings::View{content};
+            auto usage = fuzz::measureUsage([&] { fuzz::runStage(stage, input); });
+            EXPECT_TRUE(fuzz::isWithinAllocations(fuzz::stageBudget(stage), content.size(), usage))
+                << entry.path() << ": " << usage.allocatedBytes << " bytes allocated";
+            count++;
+        }
+    }
+    EXPECT_GT(count, 0);
+}
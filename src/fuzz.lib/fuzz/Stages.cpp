@@ -0,0 +1,120 @@
+#include "Stages.h"
+
+#include "filter/filterTokens.h"
+#include "nesting/nestTokens.h"
+#include "parser/Parser.h"
+#include "scanner/tokenize.h"
+#include "strings/utf8Decode.h"
+#include "text/decodePosition.h"
+
+#include "api/Context.h"
+#include "intrinsic/Adapter.h"
+#include "intrinsic/ResolveType.h"
+
+#include "diagnostic/Diagnostic.ostream.h"
+#include "nesting/Token.ostream.h"
+#include "parser/Expression.ostream.h"
+#include "scanner/Token.ostream.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace fuzz {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct IntrinsicType {
+    const instance::Scope* globals;
+
+    template<class T>
+    auto operator()(meta::Type<T>) const -> instance::TypeView {
+        return intrinsic::ResolveType<T>::template moduleInstance<intrinsic::Rebuild>(globals);
+    }
+};
+
+auto globals() -> const instance::ScopePtr& {
+    static const auto scope = [] {
+        auto r = std::make_shared<instance::Scope>();
+        r->emplace(intrinsicAdapter::Adapter::moduleOf(meta::type<intrinsic::Rebuild>));
+        return r;
+    }();
+    return scope;
+}
+
+auto decode(strings::View input) { return strings::utf8Decode(input); }
+auto tokenize(strings::View input) {
+    return scanner::tokenize(text::decodePosition(input, text::Config{text::Column{8}}));
+}
+auto filter(strings::View input) { return filter::filterTokens(tokenize(input)); }
+auto nest(strings::View input) { return nesting::nestTokens(filter(input)); }
+
+void parse(strings::View input) {
+    const auto& scope = globals();
+    auto context = parser::ComposeContext{
+        [&](strings::View id) { return scope->byName(id); },
+        [](const parser::Call&) -> parser::OptValueExpr { return {}; }, // no compile time execution
+        IntrinsicType{scope.get()},
+    };
+    (void)parser::Parser::parseBlock(nest(input), context);
+}
+
+} // namespace
+
+auto stageName(Stage stage) -> const char* {
+    switch (stage) {
+    case Stage::utf8Decode: return "utf8Decode";
+    case Stage::tokenize: return "tokenize";
+    case Stage::filterTokens: return "filterTokens";
+    case Stage::nestTokens: return "nestTokens";
+    case Stage::parseBlock: return "parseBlock";
+    }
+    return "";
+}
+
+// generous budgets - we look for super linear behavior not for small regressions
+auto stageBudget(Stage stage) -> Budget {
+    switch (stage) {
+    case Stage::utf8Decode: return {100ms, 2us, 64 * 1024, 256};
+    case Stage::tokenize: return {100ms, 10us, 64 * 1024, 2 * 1024};
+    case Stage::filterTokens: return {100ms, 10us, 64 * 1024, 4 * 1024};
+    case Stage::nestTokens: return {100ms, 20us, 64 * 1024, 8 * 1024};
+    case Stage::parseBlock: return {200ms, 50us, 256 * 1024, 16 * 1024};
+    }
+    return {};
+}
+
+void runStage(Stage stage, strings::View input) {
+    switch (stage) {
+    case Stage::utf8Decode:
+        for ([[maybe_unused]] auto&& d : decode(input)) {}
+        return;
+    case Stage::tokenize:
+        for ([[maybe_unused]] auto&& t : tokenize(input)) {}
+        return;
+    case Stage::filterTokens:
+        for ([[maybe_unused]] auto&& l : filter(input)) {}
+        return;
+    case Stage::nestTokens: (void)nest(input); return;
+    case Stage::parseBlock: parse(input); return;
+    }
+}
+
+void fuzzStage(Stage stage, const uint8_t* data, size_t size) {
+    auto begin = reinterpret_cast<const char*>(data);
+    auto input = strings::View{begin, begin + size};
+    auto usage = measureUsage([&] { runStage(stage, input); });
+    if (isWithin(stageBudget(stage), size, usage)) return;
+
+    std::fprintf(
+        stderr,
+        "%s exceeded budget: %zu bytes input, %lld us, %llu bytes allocated\n",
+        stageName(stage),
+        size,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(usage.time).count()),
+        static_cast<unsigned long long>(usage.allocatedBytes));
+    std::abort();
+}
+
+} // namespace fuzz
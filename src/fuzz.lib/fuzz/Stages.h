@@ -0,0 +1,34 @@
+#pragma once
+#include "Budget.h"
+
+#include "strings/View.h"
+
+namespace fuzz {
+
+/// pipeline stages - each stage runs all the stages before it
+enum class Stage {
+    utf8Decode,
+    tokenize,
+    filterTokens,
+    nestTokens,
+    parseBlock,
+};
+constexpr Stage allStages[] = {
+    Stage::utf8Decode,
+    Stage::tokenize,
+    Stage::filterTokens,
+    Stage::nestTokens,
+    Stage::parseBlock,
+};
+
+auto stageName(Stage stage) -> const char*;
+auto stageBudget(Stage stage) -> Budget;
+
+/// runs the pipeline up to the stage on the input
+void runStage(Stage stage, strings::View input);
+
+/// entry point for LLVMFuzzerTestOneInput
+// aborts if the budget is exceeded, so the fuzzer reports and minimizes the input
+void fuzzStage(Stage stage, const uint8_t* data, size_t size);
+
+} // namespace fuzz
@@ -0,0 +1,6 @@
+#include "Stages.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    fuzz::fuzzStage(fuzz::Stage::nestTokens, data, size);
+    return 0;
+}
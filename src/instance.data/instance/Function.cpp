@@ -1,6 +1,10 @@
 #include "Function.h"
 
 #include "Entry.h"
+#include "Module.h"
+#include "Type.h"
+
+#include <algorithm>
 
 namespace instance {
 
@@ -10,4 +14,38 @@ auto Function::lookupParameter(NameView name) const -> OptParameterView {
     return r.frontValue().get(meta::type<VariablePtr>)->parameter;
 }
 
+auto typeOf(const parser::TypeExpr& expr) -> parser::TypeView {
+    // TODO(arBmind): somehow handle computed types
+    return expr.visit(
+        [](const parser::TypeReference& tr) { return tr.type; }, //
+        [](const parser::ModuleReference& mr) -> parser::TypeView {
+            auto typeRange = mr.module->members().byName(parser::nameOfType());
+            if (typeRange.single()) return typeRange.frontValue().get<TypePtr>().get();
+            return {}; // error module is not a type
+        },
+        [](const auto&) -> parser::TypeView { return {}; } // not a type
+    );
+}
+
+auto typeOf(const Parameter& parameter) -> parser::TypeView {
+    if (parameter.variable && parameter.variable->type) return parameter.variable->type;
+    return typeOf(parameter.type);
+}
+
+auto implicitFromTypes(const Function& function) -> ImplicitFromTypes {
+    auto right = function.rightParameters();
+    auto isResult = [](const auto& p) { return p->side == ParameterSide::result; };
+    auto results = std::count_if(function.parameters.begin(), function.parameters.end(), isResult);
+    if (right.size() != 1 || results != 1) return {};
+    auto from = typeOf(*right[0]);
+    auto to = typeOf(**meta::findIf(function.parameters, isResult));
+    if (!from || !to) return {};
+    return {from, to};
+}
+
+void declareImplicitFrom(const Function& function) {
+    auto [from, to] = implicitFromTypes(function);
+    if (from && to) parser::declareImplicitFrom(from, to, &function);
+}
+
 } // namespace instance
@@ -11,6 +11,7 @@
 #include "meta/algorithm.h"
 #include "strings/View.h"
 
+#include <atomic>
 #include <set>
 
 namespace instance {
@@ -43,6 +44,7 @@ struct Function : std::enable_shared_from_this<Function> {
     LocalScope parameterScope{};
     Parameters parameters{};
     ScopePtr parserScope{}; // only set if more parsing is required
+    mutable std::atomic<uint32_t> callProfile{}; ///< packed execution analysis - 0 until it is computed once
 
     auto lookupParameter(NameView name) const -> OptParameterView;
     auto leftParameters() const -> ParameterRange {
@@ -63,4 +65,20 @@ struct Function : std::enable_shared_from_this<Function> {
 };
 using FunctionPtr = std::shared_ptr<Function>;
 
+/// the type named by a type expression - nullptr for computed types and modules without a type
+auto typeOf(const parser::TypeExpr&) -> parser::TypeView;
+/// the type of a parameter - user declared parameters only carry their type expression
+auto typeOf(const Parameter&) -> parser::TypeView;
+
+/// source and target type of a conversion
+struct ImplicitFromTypes {
+    parser::TypeView from{};
+    parser::TypeView to{};
+};
+/// implicitFrom converts its single right parameter into its single result - both are nullptr otherwise
+auto implicitFromTypes(const Function&) -> ImplicitFromTypes;
+
+/// registers the conversion on its target type - only used for intrinsics while their module is built
+void declareImplicitFrom(const Function&);
+
 } // namespace instance
@@ -3,8 +3,12 @@
 #include "instance/Views.h"
 #include "parser/Expression.h"
 
+#include <functional>
+
 namespace intrinsic {
 
+using ParseBlock = std::function<parser::Block(const parser::BlockLiteral& block, const instance::ScopePtr& scope)>;
+
 struct ContextInterface {
     instance::ScopePtr parserScope{};
     const instance::Scope* executionScope{};
@@ -17,8 +21,14 @@ struct ContextInterface {
     [[nodiscard]] virtual auto parse(const parser::BlockLiteral& block, const instance::ScopePtr& scope) const
         -> parser::Block = 0;
 
+    /// parser that may run after this context is gone - empty if modules are parsed immediately
+    [[nodiscard]] virtual auto lazyModuleParser() const -> ParseBlock { return {}; }
+
     /// report diagnostics from the C++ API
     virtual void report(diagnostic::Diagnostic diagnostic) = 0;
+
+    /// write compile time output
+    virtual void output(strings::View text) = 0;
 };
 
 } // namespace intrinsic
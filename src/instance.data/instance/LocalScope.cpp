@@ -1,6 +1,7 @@
 #include "LocalScope.h"
 
 #include "Entry.h"
+#include "Scope.h"
 
 namespace instance {
 
@@ -18,6 +19,23 @@ auto LocalScope::end() noexcept -> EntryByName::It { return m.end(); }
 auto LocalScope::begin() const noexcept -> EntryByName::cIt { return m.begin(); }
 auto LocalScope::end() const noexcept -> EntryByName::cIt { return m.end(); }
 
-auto LocalScope::emplace(Entry&& entry) & -> void { m.insert(std::move(entry)); }
+const meta::EventCounter localScopeInserts{"LocalScope.emplace"};
+
+auto LocalScope::emplace(Entry&& entry) & -> void {
+    localScopeInserts.add();
+    if (entry.holds<FunctionPtr>()) {
+        const auto& function = entry.get<FunctionPtr>();
+        if (NameView{function->name}.isContentEqual(NameView{"implicitFrom"})) {
+            auto [from, to] = implicitFromTypes(*function);
+            if (from && to) m_implicitFrom[{from, to}] = function.get();
+        }
+    }
+    m.insert(std::move(entry));
+}
+
+auto LocalScope::implicitFrom(parser::TypeView from, parser::TypeView to) const& -> FunctionView {
+    auto it = m_implicitFrom.find({from, to});
+    return it != m_implicitFrom.end() ? it->second : nullptr;
+}
 
 } // namespace instance
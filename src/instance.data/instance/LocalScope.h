@@ -1,11 +1,14 @@
 #pragma once
 #include "Type.h"
 
+#include "meta/Hash.h"
 #include "meta/Same.h"
 #include "meta/Variant.h"
 #include "strings/View.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace instance {
@@ -98,11 +101,21 @@ using EntryByName = OrderedVector<Entry, EntryLess>;
 using EntryRange = Range<EntryByName::It>;
 using ConstEntryRange = Range<EntryByName::cIt>;
 
+/// source and target type of a conversion
+using ImplicitFromKey = std::pair<parser::TypeView, parser::TypeView>;
+struct ImplicitFromKeyHash {
+    auto operator()(const ImplicitFromKey& key) const -> size_t {
+        return meta::hashCombine(meta::hashOf(key.first), meta::hashOf(key.second));
+    }
+};
+using ImplicitFromIndex = std::unordered_map<ImplicitFromKey, FunctionView, ImplicitFromKeyHash>;
+
 struct LocalScope {
     using This = LocalScope;
 
 private:
     EntryByName m; // note map is not fully known here, so we implement all life cycle methods
+    ImplicitFromIndex m_implicitFrom; // functions named implicitFrom by source and target type
 
 public:
     LocalScope();
@@ -123,8 +136,12 @@ public:
     [[nodiscard]] auto begin() const noexcept -> EntryByName::cIt;
     [[nodiscard]] auto end() const noexcept -> EntryByName::cIt;
 
+    /// functions named implicitFrom are also indexed by their source and target type
     auto emplace(Entry&& entry) & -> void;
 
+    /// the conversion declared in this scope - nullptr if there is none
+    [[nodiscard]] auto implicitFrom(parser::TypeView from, parser::TypeView to) const& -> FunctionView;
+
     // bool replace(old, new)
 };
 using LocalScopePtr = std::shared_ptr<LocalScope>;
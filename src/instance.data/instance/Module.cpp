@@ -19,7 +19,9 @@ void fixTypes(Module* old, Module* cur) {
 Module::Module(This&& o) noexcept
     : name(std::move(o.name))
     , flags(std::move(o.flags))
-    , locals(std::move(o.locals)) {
+    , locals(std::move(o.locals))
+    , m_pendingBody(std::move(o.m_pendingBody))
+    , m_hasPendingBody(o.m_hasPendingBody.exchange(false)) {
     fixTypes(&o, this);
 }
 
@@ -27,8 +29,37 @@ auto Module::operator=(This&& o) & noexcept -> Module& {
     name = std::move(o.name);
     flags = std::move(o.flags);
     locals = std::move(o.locals);
+    m_pendingBody = std::move(o.m_pendingBody);
+    m_hasPendingBody = o.m_hasPendingBody.exchange(false);
     fixTypes(&o, this);
     return *this;
 }
 
+// the body may look up members of the module itself, so it is cleared first
+// the flag is only reset after the body ran - other threads block on the mutex until then
+auto Module::members() const -> const LocalScope& {
+    if (m_hasPendingBody.load(std::memory_order_acquire)) {
+        auto lock = std::unique_lock{m_pendingMutex};
+        if (m_pendingBody) {
+            auto body = std::move(m_pendingBody);
+            m_pendingBody = {};
+            body();
+            m_hasPendingBody.store(false, std::memory_order_release);
+        }
+    }
+    return locals;
+}
+
+void Module::deferBody(std::function<void()> body) {
+    auto lock = std::unique_lock{m_pendingMutex};
+    m_pendingBody = std::move(body);
+    m_hasPendingBody.store(static_cast<bool>(m_pendingBody), std::memory_order_release);
+}
+
+void Module::dropPendingBody() {
+    auto lock = std::unique_lock{m_pendingMutex};
+    m_pendingBody = {};
+    m_hasPendingBody.store(false, std::memory_order_release);
+}
+
 } // namespace instance
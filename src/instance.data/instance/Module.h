@@ -5,6 +5,10 @@
 #include "strings/String.h"
 #include "strings/View.h"
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
 namespace instance {
 
 using Name = strings::String;
@@ -23,6 +27,14 @@ struct Module {
     ModuleFlags flags{};
     LocalScope locals{};
 
+    /// locals after a pending body was parsed - lookups of members have to use this
+    // the body is parsed exactly once, concurrent lookups wait for it
+    [[nodiscard]] auto members() const -> const LocalScope&;
+
+    void deferBody(std::function<void()> body); ///< parses the body of a lazily declared module on first lookup
+    void dropPendingBody(); ///< the body is never parsed
+    [[nodiscard]] bool hasPendingBody() const { return m_hasPendingBody.load(std::memory_order_acquire); }
+
     Module() = default;
     ~Module() = default;
     // no copy
@@ -31,6 +43,11 @@ struct Module {
     // movable
     Module(This&& o) noexcept;
     auto operator=(This&& o) & noexcept -> Module&;
+
+private:
+    mutable std::recursive_mutex m_pendingMutex{}; // the body itself may look up members of this module
+    mutable std::function<void()> m_pendingBody{};
+    mutable std::atomic<bool> m_hasPendingBody{};
 };
 using ModulePtr = std::shared_ptr<Module>;
 using ModuleView = const Module*;
@@ -53,6 +53,10 @@ struct ParameterBuilder {
         parameter->side = ParameterSide::result;
         return std::move(*this);
     }
+    [[nodiscard]] auto reference() && -> ParameterBuilder {
+        parameter->flags |= ParameterFlag::reference;
+        return std::move(*this);
+    }
     // auto optional() && -> ParameterBuilder {
     //     parameter->flags |= ParameterFlag::optional;
     //     return std::move(*this);
@@ -19,8 +19,9 @@ enum class ParameterFlag {
     run_time = 1 << 3, ///< variable is usable at runtime
 
     splatted = 1 << 4, // array values are gathered during call
-    // token = 1 << 5, // unparsed token
-    // expression = 1 << 6, // unevaluated expression
+    reference = 1 << 5, // passed as pointer to an immutable value
+    // token = 1 << 6, // unparsed token
+    // expression = 1 << 7, // unevaluated expression
     // …
 };
 using ParameterFlags = meta::Flags<ParameterFlag>;
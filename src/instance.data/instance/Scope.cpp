@@ -2,6 +2,7 @@
 
 namespace instance {
 
-// empty
+const meta::EventCounter scopeLookups{"Scope.byName"};
+const meta::EventCounter scopeLookupSteps{"Scope.byName.steps"};
 
 } // namespace instance
@@ -2,11 +2,17 @@
 #include "Entry.h"
 #include "LocalScope.h"
 
+#include "meta/EventCounter.h"
+
 namespace instance {
 
 struct Scope;
 using ConstScopePtr = std::shared_ptr<const Scope>;
 
+extern const meta::EventCounter scopeLookups; ///< calls of Scope::byName
+extern const meta::EventCounter scopeLookupSteps; ///< scopes visited by Scope::byName
+extern const meta::EventCounter localScopeInserts; ///< calls of LocalScope::emplace
+
 struct Scope {
     using This = Scope;
 
@@ -33,11 +39,22 @@ struct Scope {
     Scope& operator=(const This&) = delete;
 
     [[nodiscard]] auto byName(NameView name) const& -> ConstEntryRange {
-        if (auto range = locals->byName(name); !range.empty()) return range;
-        if (parent) return parent->byName(name);
+        scopeLookups.add();
+        for (const auto* scope = this; scope != nullptr; scope = scope->parent.get()) {
+            scopeLookupSteps.add();
+            if (auto range = scope->locals->byName(name); !range.empty()) return range;
+        }
         return {};
     }
 
+    /// the innermost conversion from one type into another - nullptr if none is visible
+    [[nodiscard]] auto implicitFrom(parser::TypeView from, parser::TypeView to) const& -> FunctionView {
+        for (const auto* scope = this; scope != nullptr; scope = scope->parent.get()) {
+            if (auto function = scope->locals->implicitFrom(from, to); function) return function;
+        }
+        return nullptr;
+    }
+
     auto emplace(Entry&& entry) & -> void { locals->emplace(std::move(entry)); }
 };
 
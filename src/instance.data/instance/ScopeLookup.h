@@ -16,7 +16,7 @@ inline auto lookup(const Scope& scope, NameView name) -> const Entry& {
         auto& entry = *range.begin();
         entry.visit(
             [&](const ModulePtr& m) -> decltype(auto) {
-                range = m->locals.byName(Name{it, it2});
+                range = m->members().byName(Name{it, it2});
             },
             [](const auto&) { throw "not a module!"; } //
         );
@@ -31,7 +31,7 @@ auto lookupA(const Scope& scope, NameView name) -> const T& {
     if constexpr (std::is_same_v<T, TypePtr>) {
         if (!c.holds<ModulePtr>()) throw "wrong type";
         const auto& m = c.get<ModulePtr>();
-        auto tr = m->locals.byName(Name{"type"});
+        auto tr = m->members().byName(Name{"type"});
         if (!tr.single()) throw "wrong type";
         return tr.frontValue().get<T>();
     }
@@ -4,6 +4,10 @@
 
 #include "parser/Type.builder.h"
 
+#include "meta/Hash.h"
+
+#include <type_traits>
+
 namespace instance {
 
 namespace details {
@@ -51,12 +55,20 @@ struct TypeModuleBuilder {
         type_->equalFunc = f;
         return std::move(*this);
     }
+    [[nodiscard]] auto hash(parser::HashFunc* f) && -> This {
+        type_->hashFunc = f;
+        return std::move(*this);
+    }
 #ifdef VALUE_DEBUG_DATA
     [[nodiscard]] auto debugData(parser::DebugDataFunc* f) && -> This {
         type_->debugDataFunc = f;
         return std::move(*this);
     }
 #endif
+    [[nodiscard]] auto trivial(bool trivial) && -> This {
+        type_->trivial = trivial;
+        return std::move(*this);
+    }
     [[nodiscard]] auto parser(parser::TypeParser parser) && -> This {
         type_->typeParser = parser;
         return std::move(*this);
@@ -76,6 +88,15 @@ auto typeMod(const char (&name)[N]) {
 
 template<class T, size_t N>
 auto typeModT(const char (&name)[N]) {
+    auto hashFunc = [] {
+        parser::HashFunc* f{};
+        if constexpr (meta::is_hashable<T>) {
+            f = [](const void* source) -> size_t {
+                return meta::hashOf(*std::launder(reinterpret_cast<const T*>(source)));
+            };
+        }
+        return f;
+    }();
     return details::TypeModuleBuilder{name}
         .size(sizeof(T))
         .align(alignof(T))
@@ -85,6 +106,8 @@ auto typeModT(const char (&name)[N]) {
         .equal([](const void* a, const void* b) -> bool {
             return *std::launder(reinterpret_cast<const T*>(a)) == *std::launder(reinterpret_cast<const T*>(b));
         })
+        .hash(hashFunc)
+        .trivial(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>)
 #ifdef VALUE_DEBUG_DATA
         .debugData([](std::ostream& out, const void* dest) -> std::ostream& {
             return out << *std::launder(reinterpret_cast<const T*>(dest));
@@ -12,11 +12,15 @@
 #include "instance/Scope.h"
 #include "instance/Type.h"
 
+#include "serialize/parser.h"
+
+#include "meta/Hash.h"
 #include "meta/Pointer.h"
 #include "meta/TypeList.h"
 
 #include <cassert>
 #include <map>
+#include <type_traits>
 
 namespace intrinsicAdapter {
 
@@ -149,7 +153,13 @@ struct Adapter {
                 r->equalFunc = [](const void* a, const void* b) -> bool {
                     return *std::launder(reinterpret_cast<const T*>(a)) == *std::launder(reinterpret_cast<const T*>(b));
                 };
+                if constexpr (meta::is_hashable<T>) {
+                    r->hashFunc = [](const void* source) -> size_t {
+                        return meta::hashOf(*std::launder(reinterpret_cast<const T*>(source)));
+                    };
+                }
                 r->typeParser = typeParser(info.parser);
+                r->trivial = std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>;
 #ifdef VALUE_DEBUG_DATA
                 r->debugDataFunc = [](std::ostream& out, const void* source) -> std::ostream& {
                     const T& value = *std::launder(reinterpret_cast<const T*>(source));
@@ -159,6 +169,7 @@ struct Adapter {
                 return r;
             }();
 
+            if constexpr (serialize::is_serializable<T>) serialize::registerType<T>(type);
             moduleBuilder.instanceModule->locals.emplace(type);
             types.map[info.name.data()] = type.get();
 
@@ -211,6 +222,7 @@ struct Adapter {
         auto indices = std::make_index_sequence<sizeof...(ExternParams)>{};
         trackParameters<ExternParams...>(r->parameters, indices);
 
+        if (info.name == intrinsic::Name{".implicitFrom"}) types.conversions.push_back(r.get());
         instanceModule->locals.emplace(std::move(r));
     }
 
@@ -223,9 +235,11 @@ private:
     };
     using Parameters = std::vector<ParameterRef>;
     using TypeMap = std::map<const char*, instance::TypeView>;
+    using Conversions = std::vector<instance::FunctionView>;
     struct Types {
         TypeMap map{};
         Parameters parameters{};
+        Conversions conversions{}; // implicitFrom functions - registered once all types are resolved
         // TODO(arBmind): add instance types etc.
     };
 
@@ -245,6 +259,7 @@ private:
             }
             parameter->variable->type = typeIt->second;
         }
+        for (auto function : types.conversions) instance::declareImplicitFrom(*function);
         // TODO(arBmind): resolve other types
     }
 
@@ -363,6 +378,9 @@ private:
         if (flags.any(ParameterFlag::Unrolled)) {
             r |= instance::ParameterFlag::splatted;
         }
+        if (flags.any(ParameterFlag::Reference)) {
+            r |= instance::ParameterFlag::reference;
+        }
         return r;
     }
 
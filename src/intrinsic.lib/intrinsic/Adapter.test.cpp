@@ -359,3 +359,19 @@ TEST(intrinsic, call) {
 
     ASSERT_EQ(result, 23u + 42);
 }
+
+TEST(intrinsic, implicitFrom) {
+    using namespace intrinsic;
+    using View = strings::View;
+    using Adapter = intrinsicAdapter::Adapter;
+    auto rebuild = Adapter::moduleOf<Rebuild>();
+    auto typeOf = [&](View name) {
+        const auto& module = rebuild->locals.byName(name).frontValue().get<instance::ModulePtr>();
+        return module->locals.byName(View{"type"}).frontValue().get<instance::TypePtr>().get();
+    };
+    const auto& u64 = rebuild->locals.byName(View{"u64"}).frontValue().get<instance::ModulePtr>();
+    const auto& implicitFrom = u64->locals.byName(View{".implicitFrom"}).frontValue().get<instance::FunctionPtr>();
+
+    EXPECT_EQ(parser::implicitFrom(typeOf(View{"NumberLiteral"}), typeOf(View{"u64"})), implicitFrom.get());
+    EXPECT_EQ(parser::implicitFrom(typeOf(View{"str"}), typeOf(View{"u64"})), nullptr);
+}
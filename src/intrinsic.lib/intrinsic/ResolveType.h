@@ -17,8 +17,10 @@ struct ResolveType {
     const instance::LocalScope* scope;
     instance::TypeView result{};
 
+    /// the module is searched in the scope and its parents (forked compilers declare it in a parent)
     template<class T>
     static auto moduleInstance(const instance::Scope* scope) -> instance::TypeView {
+        while (scope->parent && scope->locals->byName(T::info().name).empty()) scope = scope->parent.get();
         auto r = This{scope->locals.get()};
         r.template module<T>();
         return r.result;
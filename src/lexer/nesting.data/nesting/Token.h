@@ -2,6 +2,8 @@
 
 #include "filter/Token.h"
 
+#include "meta/CopyOnWrite.h"
+
 namespace nesting {
 
 using filter::BlockEndIdentifier;
@@ -53,14 +55,18 @@ struct BlockLine {
 };
 using BlockLines = std::vector<BlockLine>;
 
+/// lines are shared between copies
+// passing a block literal around (eg. as function body) does not copy the nested tokens
+// note: sharing does not extend the lifetime of the source text - tokens are views into it,
+//   so the owner of the text (eg. the SourceManager of rec::Compiler) has to outlive every copy
 struct BlockLiteralValue {
     using This = BlockLiteralValue;
-    BlockLines lines{};
+    meta::CopyOnWrite<BlockLines> lines{};
 
     auto hasErrors() const -> bool { return false; }
 
-    bool operator!=(const This& o) const { return lines != o.lines; }
-    bool operator==(const This& o) const { return lines == o.lines; }
+    bool operator!=(const This& o) const { return !(*this == o); }
+    bool operator==(const This& o) const { return lines.isSame(o.lines) || *lines == *o.lines; }
 };
 
 using BlockLiteral = scanner::details::ValueToken<BlockLiteralValue>;
@@ -61,7 +61,7 @@ inline auto nestTokens(meta::CoEnumerator<FilterTokenLine> input) -> BlockLitera
     };
     auto findBlockInputEnd = [](const BlockLiteralValue& b) {
         auto it = strings::View::It{};
-        for (auto& l : b.lines) {
+        for (auto& l : *b.lines) {
             l.forEach([&](auto& t) {
                 auto te = t.visit([](auto& x) { return x.input.end(); });
                 if (!it || (te && te > it)) it = te;
@@ -216,7 +216,7 @@ inline auto nestTokens(meta::CoEnumerator<FilterTokenLine> input) -> BlockLitera
                 auto err = input->newLine();
                 BlockLiteralValue block = parseBlock(parentBlockColumn, nextIndent, parseBlock, parseLine);
                 {
-                    auto& v = block.lines.front().insignificants;
+                    auto& v = block.lines.modify().front().insignificants;
                     v.insert(v.begin(), UnexpectedIndent{err});
                 }
                 line.tokens.push_back(BlockLiteral{{}, std::move(block)});
@@ -250,31 +250,31 @@ inline auto nestTokens(meta::CoEnumerator<FilterTokenLine> input) -> BlockLitera
                     }
                     if (nextType == LineType::WithEnd) {
                         joinLines(line, std::move(nextLine));
-                        block.lines.push_back(std::move(line));
+                        block.lines.modify().push_back(std::move(line));
                         if (!input) return block;
                         break;
                     }
                     if (nextType == LineType::Standalone) {
                         line.insignificants.push_back(MissingBlockEnd{{{}, position}});
-                        block.lines.push_back(std::move(line));
-                        block.lines.push_back(std::move(nextLine));
+                        block.lines.modify().push_back(std::move(line));
+                        block.lines.modify().push_back(std::move(nextLine));
                         break;
                     }
                     if (nextType == LineType::LeaveBlock || nextType == LineType::BlockStartLeave) {
                         line.insignificants.push_back(MissingBlockEnd{{{}, position}});
-                        block.lines.push_back(std::move(line));
-                        block.lines.push_back(std::move(nextLine));
+                        block.lines.modify().push_back(std::move(line));
+                        block.lines.modify().push_back(std::move(nextLine));
                         return block;
                     }
                 }
             }
             else if (type == LineType::BlockStartLeave) {
                 line.insignificants.push_back(MissingBlockEnd{{{}, position}});
-                block.lines.push_back(std::move(line));
+                block.lines.modify().push_back(std::move(line));
                 return block;
             }
             else {
-                block.lines.push_back(std::move(line));
+                block.lines.modify().push_back(std::move(line));
                 if (type == LineType::LeaveBlock) return block;
                 if (type == LineType::WithEnd && !input) return block;
             }
@@ -35,7 +35,7 @@ inline auto operator<<(std::ostream& out, const BlockLiteralValue& b) -> std::os
     auto indent = parentIndent + 1;
     out.iword(indentIndex) = indent;
 
-    for (const auto& line : b.lines) {
+    for (const auto& line : *b.lines) {
         for (auto i = 0; i <= indent; i++) out << "  ";
         out << line << '\n';
     }
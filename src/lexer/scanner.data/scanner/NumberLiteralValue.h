@@ -1,4 +1,5 @@
 #pragma once
+#include <meta/Hash.h>
 #include <strings/Rope.h>
 #include <text/DecodedPosition.h>
 
@@ -70,6 +71,14 @@ struct NumberLiteralValue {
             && errors == o.errors;
     }
     bool operator!=(const This& o) const noexcept { return !(*this == o); }
+
+    // note: has to match operator== above (errors are not hashed)
+    auto hash() const -> size_t {
+        if (radix == Radix::invalid) return {};
+        auto h = meta::hashCombine(static_cast<size_t>(radix), integerPart.hash());
+        h = meta::hashCombine(h, fractionalPart.hash());
+        return meta::hashCombine(h, exponentPart.hash());
+    }
 };
 
 } // namespace scanner
@@ -43,6 +43,8 @@ struct StringLiteralValue {
 
     bool operator==(const This& o) const { return o.text == text && o.errors == errors; }
     bool operator!=(const This& o) const { return !(*this == o); }
+
+    auto hash() const -> size_t { return text.hash(); } // errors are rare and not hashed
 };
 
 } // namespace scanner
@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace scanner {
+
+/// token class determined by the first (ASCII) byte of a token
+enum class ByteClass : uint8_t {
+    unicode, // >= 0x80 - requires the full Unicode classification
+    whiteSpace,
+    decimalNumber,
+    string,
+    comment,
+    colon,
+    comma,
+    semicolon,
+    squareBracketOpen,
+    squareBracketClose,
+    bracketOpen,
+    bracketClose,
+    identifier,
+    dot, // member identifier or unexpected character
+    operatorSign,
+    unexpected,
+};
+
+namespace details {
+
+constexpr auto buildByteClasses() -> std::array<ByteClass, 256> {
+    auto r = std::array<ByteClass, 256>{};
+    for (auto c = 0u; c < 0x80; c++) r[c] = ByteClass::unexpected;
+    // bytes >= 0x80 stay ByteClass::unicode
+
+    r[0x0C] = ByteClass::whiteSpace; // form feed
+    r[' '] = ByteClass::whiteSpace;
+    for (auto c = '0'; c <= '9'; c++) r[c] = ByteClass::decimalNumber;
+    for (auto c = 'a'; c <= 'z'; c++) r[c] = ByteClass::identifier;
+    for (auto c = 'A'; c <= 'Z'; c++) r[c] = ByteClass::identifier;
+    r['_'] = ByteClass::identifier;
+    r['.'] = ByteClass::dot;
+
+    r['"'] = ByteClass::string;
+    r['#'] = ByteClass::comment;
+    r[':'] = ByteClass::colon;
+    r[','] = ByteClass::comma;
+    r[';'] = ByteClass::semicolon;
+    r['['] = ByteClass::squareBracketOpen;
+    r[']'] = ByteClass::squareBracketClose;
+    r['('] = ByteClass::bracketOpen;
+    r[')'] = ByteClass::bracketClose;
+
+    // see extractOperator: math, other symbols, other punctuation and open/close punctuations
+    for (auto c : "!%&'*+-/<=>?@\\|~{}") {
+        if (c != 0) r[static_cast<uint8_t>(c)] = ByteClass::operatorSign;
+    }
+    return r;
+}
+
+} // namespace details
+
+/// constexpr lookup of the token class for each first byte
+constexpr auto byteClasses = details::buildByteClasses();
+
+constexpr auto byteClassOf(uint32_t codePoint) -> ByteClass {
+    return codePoint < 0x80 ? byteClasses[codePoint] : ByteClass::unicode;
+}
+
+} // namespace scanner
@@ -0,0 +1,32 @@
+#include <scanner/ByteClass.h>
+
+#include <strings/CodePoint.h>
+
+#include <gtest/gtest.h>
+
+using namespace scanner;
+
+// the table has to agree with the Unicode classification used by the extractors
+TEST(byteClass, matchesCodePointClassification) {
+    for (auto c = 0u; c < 0x80; c++) {
+        auto cp = strings::CodePoint{c};
+        auto isOperator = cp == '-' || cp.isSymbolMath() || cp.isSymbolOther() || cp.isNumberOther() ||
+            (cp.isSymbolCurrency() && c != '$') || (cp.isPunctuationOther() && c != '.') || c == '{' || c == '}';
+        auto cls = byteClassOf(c);
+
+        EXPECT_EQ(cp.isWhiteSpace(), cls == ByteClass::whiteSpace) << c;
+        EXPECT_EQ(cp.isDecimalNumber(), cls == ByteClass::decimalNumber) << c;
+        EXPECT_EQ(cp.isLetter() || cp.isPunctuationConnector(), cls == ByteClass::identifier) << c;
+        switch (cls) {
+        case ByteClass::operatorSign: EXPECT_TRUE(isOperator) << c; break;
+        case ByteClass::unexpected: EXPECT_FALSE(isOperator) << c; break;
+        default: break;
+        }
+    }
+}
+
+TEST(byteClass, unicode) {
+    EXPECT_EQ(ByteClass::unicode, byteClassOf(0x80));
+    EXPECT_EQ(ByteClass::unicode, byteClassOf(0x3000));
+    EXPECT_EQ(ByteClass::unicode, byteClasses[0xFF]);
+}
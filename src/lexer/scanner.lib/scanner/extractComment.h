@@ -39,6 +39,7 @@ inline auto extractComment(CodePointPosition firstCpp, meta::CoEnumerator<Decode
                     return true;
                 },
                 [&](NewlinePosition&) { return false; },
+                [&](text::IndentationPosition&) { return false; },
                 [&](CodePointPosition& cpp) {
                     updateEnd(cpp);
                     return true;
@@ -62,6 +63,10 @@ inline auto extractComment(CodePointPosition firstCpp, meta::CoEnumerator<Decode
                     updateEnd(nlp);
                     return true;
                 },
+                [&](text::IndentationPosition& ip) {
+                    updateEnd(ip);
+                    return true;
+                },
                 [&](CodePointPosition& cpp) {
                     updateEnd(cpp);
                     auto b = cpp.input.end() - marker.size();
@@ -85,6 +90,7 @@ inline auto extractComment(CodePointPosition firstCpp, meta::CoEnumerator<Decode
                 return true;
             },
             [&](NewlinePosition&) { return false; },
+            [&](text::IndentationPosition&) { return false; },
             [&](CodePointPosition& cpp) {
                 decoded++;
                 updateEnd(cpp);
@@ -7,6 +7,7 @@ namespace scanner {
 
 using text::CodePointPosition;
 using text::DecodedPosition;
+using text::IndentationPosition;
 using text::NewlinePosition;
 
 struct ExtractNewLineState {
@@ -38,6 +39,26 @@ inline auto extractNewLineIndentation(
                 continue;
             }
         }
+        else if (decoded->holds<IndentationPosition>()) {
+            // spaces and tabs measured by decodePosition
+            auto ip = decoded->get<IndentationPosition>();
+            auto first = text::CodePoint{static_cast<uint8_t>(*ip.input.begin())};
+            if (!state.codePoint) state.codePoint = first;
+            if (!isMixed) {
+                auto isFirstMixed = first != state.codePoint;
+                auto offset = isFirstMixed ? size_t{} : ip.mixedOffset;
+                if (offset < ip.input.size()) {
+                    auto mixed = ip.input.begin() + offset;
+                    newLine.errors.emplace_back(
+                        MixedIndentCharacter{View{mixed, mixed + 1}, isFirstMixed ? ip.position : ip.mixedPosition});
+                    isMixed = true;
+                }
+            }
+            end = ip.input.end();
+            newLine.indentColumn = ip.endPosition.column;
+            decoded++;
+            continue;
+        }
         else if (decoded->holds<DecodedErrorPosition>()) {
             auto dep = decoded->get<DecodedErrorPosition>();
             newLine.errors.push_back(dep);
@@ -127,6 +127,11 @@ inline auto extractString(CodePointPosition firstCpp, meta::CoEnumerator<Decoded
                     spaces = {};
                     return true;
                 },
+                [&](text::IndentationPosition& ip) {
+                    updateEnd(ip);
+                    spaces += ip.input;
+                    return true;
+                },
                 [&](CodePointPosition& cpp) {
                     updateEnd(cpp);
                     auto cp = cpp.codePoint;
@@ -244,6 +249,11 @@ inline auto extractString(CodePointPosition firstCpp, meta::CoEnumerator<Decoded
                     spaces = {};
                     return true;
                 },
+                [&](text::IndentationPosition& ip) {
+                    updateEnd(ip);
+                    spaces += ip.input;
+                    return true;
+                },
                 [&](CodePointPosition& cpp) {
                     updateEnd(cpp);
                     auto cp = cpp.codePoint;
@@ -0,0 +1,59 @@
+#include <scanner/tokenize.h>
+
+#include <instrumentation/Profile.h>
+#include <instrumentation/Profile.ostream.h>
+#include <text/decodePosition.h>
+
+#include <strings/View.h>
+#include <strings/utf8Decode.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr auto iterations = 20;
+constexpr auto config = text::Config{text::Column{8}};
+
+template<class Decode>
+void bench(const char* name, const std::string& source, Decode&& decode) {
+    auto input = strings::View{source};
+    auto profile = instrumentation::Profile{};
+    auto tokens = size_t{};
+    for (auto i = 0; i < iterations; i++) {
+        instrumentation::measure(&profile, name, [&] {
+            for (const auto& token : scanner::tokenize(decode(input))) {
+                (void)token;
+                tokens++;
+            }
+        });
+    }
+    std::cout << profile;
+    const auto& phase = profile.phases().front();
+    std::cout << "tokens: " << tokens << '\n'
+              << "ns/token: " << static_cast<double>(std::chrono::nanoseconds{phase.total.wallTime}.count()) /
+            static_cast<double>(tokens)
+              << "\n\n";
+}
+
+auto decodeCodePoints(strings::View input) { return text::decodePosition(strings::utf8Decode(input), config); }
+auto decodeSource(strings::View input) { return text::decodePosition(input, config); }
+
+} // namespace
+
+// measures the per token cost of tokenize on identifier heavy and on deeply indented code
+int main() {
+    auto identifiers = std::string{};
+    for (auto i = 0; i < 2000; i++) {
+        identifiers += "\nlet value_" + std::to_string(i) + " = first.second third fourth (fifth, sixth)";
+    }
+    bench("identifiers", identifiers, decodeSource);
+
+    auto indented = std::string{};
+    for (auto i = 0; i < 2000; i++) {
+        indented += "\n" + std::string(static_cast<size_t>(4 * (i % 16)), ' ') + "call argument";
+    }
+    bench("indented code points", indented, decodeCodePoints);
+    bench("indented source", indented, decodeSource);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "ByteClass.h"
 #include "extractComment.h"
 #include "extractIdentifier.h"
 #include "extractNewLineIndentation.h"
@@ -20,6 +21,7 @@ using text::DecodedPosition;
 inline auto tokenize(meta::CoEnumerator<DecodedPosition> decoded) -> meta::CoEnumerator<Token> {
     using text::CodePointPosition;
     using text::DecodedErrorPosition;
+    using text::IndentationPosition;
     using text::NewlinePosition;
     using text::View;
 
@@ -52,21 +54,27 @@ inline auto tokenize(meta::CoEnumerator<DecodedPosition> decoded) -> meta::CoEnu
         co_yield current.visit(
             [&](CodePointPosition cpp) -> Token {
                 auto chr = cpp.codePoint;
-                if (chr.isWhiteSpace()) return extractWhitespaces(cpp);
-                if (chr.isDecimalNumber()) return extractNumber(cpp, decoded);
-
-                switch (chr.v) {
-                case '"': return extractString(cpp, decoded);
-                case '#': return extractComment(cpp, decoded);
-                case ':': return extractChar(type<ColonSeparator>, cpp);
-                case ',': return extractChar(type<CommaSeparator>, cpp);
-                case ';': return extractChar(type<SemicolonSeparator>, cpp);
-                case '[': return extractChar(type<SquareBracketOpen>, cpp);
-                case ']': return extractChar(type<SquareBracketClose>, cpp);
-                case '(': return extractChar(type<BracketOpen>, cpp);
-                case ')': return extractChar(type<BracketClose>, cpp);
+                switch (byteClassOf(chr.v)) {
+                case ByteClass::whiteSpace: return extractWhitespaces(cpp);
+                case ByteClass::decimalNumber: return extractNumber(cpp, decoded);
+                case ByteClass::string: return extractString(cpp, decoded);
+                case ByteClass::comment: return extractComment(cpp, decoded);
+                case ByteClass::colon: return extractChar(type<ColonSeparator>, cpp);
+                case ByteClass::comma: return extractChar(type<CommaSeparator>, cpp);
+                case ByteClass::semicolon: return extractChar(type<SemicolonSeparator>, cpp);
+                case ByteClass::squareBracketOpen: return extractChar(type<SquareBracketOpen>, cpp);
+                case ByteClass::squareBracketClose: return extractChar(type<SquareBracketClose>, cpp);
+                case ByteClass::bracketOpen: return extractChar(type<BracketOpen>, cpp);
+                case ByteClass::bracketClose: return extractChar(type<BracketClose>, cpp);
+                case ByteClass::identifier: return extractIdentifier(cpp, decoded).value();
+                case ByteClass::operatorSign: return extractOperator(cpp, decoded).value();
+                case ByteClass::unexpected: return UnexpectedCharacter{cpp.input, cpp.position};
+                case ByteClass::dot: break;
+                case ByteClass::unicode:
+                    if (chr.isWhiteSpace()) return extractWhitespaces(cpp);
+                    if (chr.isDecimalNumber()) return extractNumber(cpp, decoded);
+                    break;
                 }
-
                 if (auto opt = extractIdentifier(cpp, decoded); opt) return opt.value();
                 if (auto opt = extractOperator(cpp, decoded); opt) return opt.value();
                 return UnexpectedCharacter{cpp.input, cpp.position};
@@ -74,6 +82,9 @@ inline auto tokenize(meta::CoEnumerator<DecodedPosition> decoded) -> meta::CoEnu
             [&](NewlinePosition nlp) -> Token { return extractNewLineIndentation(nlp, decoded, newLineState); },
             [&](DecodedErrorPosition dep) -> Token {
                 return InvalidEncoding{dep.input, dep.position};
+            },
+            [&](IndentationPosition ip) -> Token {
+                return WhiteSpaceSeparator{ip.input, ip.position}; // only expected after newlines
             });
     }
 }
@@ -0,0 +1,83 @@
+#pragma once
+#include "Value.h"
+#include "ValueArena.h"
+
+#include "meta/Hash.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace parser {
+
+/// deduplicates the literal payloads of one compilation
+// repeated literals share one immutable payload - mutable access clones it (copy on write)
+// pooled literals carry no location - diagnostics take input and position from the tokens of the block line
+struct ConstantPool {
+    using This = ConstantPool;
+
+    template<class Literal>
+    auto intern(TypeView type, const Literal& literal) -> Value {
+        if constexpr (meta::is_hashable<decltype(literal.value)>) {
+            if (!hasTokenError(literal)) return pooled(type, literal);
+        }
+        auto value = Value{type};
+        value.set<Literal>() = literal;
+        return value;
+    }
+
+    /// pooled values before and after freeze()
+    // holds the old payloads, so their addresses stay unique while copies are rebased
+    struct Relocation {
+        ValueArena::Values old{};
+        std::unordered_map<const void*, Value> byOldPayload{};
+
+        /// replaces a copy of an old pooled value with the relocated value
+        void rebase(Value& value) const {
+            auto it = byOldPayload.find(std::as_const(value).data()); // mutable data() would clone
+            if (it != byOldPayload.end()) value = it->second;
+        }
+    };
+
+    /// moves all pooled payloads into one contiguous arena
+    // copies of the old values stay valid - rebase them to release the old payloads
+    auto freeze() -> Relocation {
+        auto relocation = Relocation{};
+        relocation.old.reserve(m_map.size());
+        for (const auto& [_, value] : m_map) relocation.old.push_back(value);
+        auto placed = ValueArena::place(relocation.old);
+        auto it = placed.values.begin();
+        for (auto& [_, value] : m_map) {
+            relocation.byOldPayload.emplace(std::as_const(value).data(), *it);
+            value = std::move(*it++);
+        }
+        m_arena = std::move(placed.arena);
+        return relocation;
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_map.size(); }
+    [[nodiscard]] auto reused() const -> size_t { return m_reused; } ///< number of literals that shared a constant
+    [[nodiscard]] auto arena() const -> const ValueArena* { return m_arena.get(); } ///< of the last freeze()
+
+private:
+    std::unordered_multimap<size_t, Value> m_map{}; // keyed by type and payload hash
+    size_t m_reused{};
+    std::shared_ptr<const ValueArena> m_arena{};
+
+    template<class Literal>
+    auto pooled(TypeView type, const Literal& literal) -> Value {
+        auto key = meta::hashCombine(meta::hashOf(type), meta::hashOf(literal.value));
+        auto [it, end] = m_map.equal_range(key);
+        for (; it != end; ++it) {
+            if (it->second.type() == type && it->second.get(meta::type<Literal>).value == literal.value) {
+                ++m_reused;
+                return it->second;
+            }
+        }
+        auto value = Value{type};
+        value.set<Literal>().value = literal.value; // ropes keep viewing the source
+        return m_map.emplace(key, std::move(value))->second;
+    }
+};
+
+} // namespace parser
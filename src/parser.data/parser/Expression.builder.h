@@ -252,9 +252,9 @@ inline auto TypeNameValueTupleBuilder::build(const Scope& scope) && -> ValueExpr
     auto tuple = NameTypeValueTuple{};
     auto i = 0;
     for (auto&& ts : std::move(builders)) {
-        tuple.tuple.emplace_back(std::move(ts).build(scope));
+        auto& ntv = tuple.tuple.modify().emplace_back(std::move(ts).build(scope));
         if (references[i]) //
-            *(references[i]) = &tuple.tuple.back();
+            *(references[i]) = &ntv;
         i++;
     }
     return tuple;
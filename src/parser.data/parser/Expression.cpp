@@ -1,7 +1,33 @@
 #include "Expression.h"
 
+#include "meta/Hash.h"
+
 namespace parser {
 
+namespace {
+
+template<class T>
+auto hashNode(const T& v) -> size_t {
+    return meta::hashOf(v);
+}
+template<class T>
+auto hashNode(const std::vector<T>& v) -> size_t {
+    return meta::hashRange(v);
+}
+template<class T>
+auto hashNode(const meta::Optional<T>& o) -> size_t {
+    return o ? meta::hashCombine(1, hashNode(o.value())) : size_t{};
+}
+
+template<class... Ts>
+auto hashVariant(const meta::Variant<Ts...>& v) -> size_t {
+    return v.visit([&](const auto& a) { return meta::hashCombine(v.index().value(), hashNode(a)); });
+}
+
+} // namespace
+
+auto Block::hash() const -> size_t { return meta::hashRange(expressions); }
+
 bool NameTypeValueReference::operator==(const This& o) const {
     // note: during testing the parser generates the NameTypeValue and the reference to that,
     //   so we have no way to make sure that the pointers are equal to an expected tree.
@@ -11,4 +37,43 @@ bool NameTypeValueReference::operator==(const This& o) const {
     return nameTypeValue != nullptr && o.nameTypeValue != nullptr && nameTypeValue->name == o.nameTypeValue->name;
 }
 
+auto NameTypeValueReference::hash() const -> size_t {
+    // note: has to match operator== above
+    return nameTypeValue ? hashNode(nameTypeValue->name) : size_t{};
+}
+
+auto VariableReference::hash() const -> size_t { return meta::hashOf(variable); }
+
+auto TypeReference::hash() const -> size_t { return meta::hashOf(type); }
+
+auto ArgumentAssignment::hash() const -> size_t { return meta::hashRange(values, meta::hashOf(parameter)); }
+
+auto Call::hash() const -> size_t { return meta::hashRange(arguments, meta::hashOf(function)); }
+
+auto TypeExpr::hash() const -> size_t { return hashVariant(*this); }
+
+auto ModuleReference::hash() const -> size_t { return meta::hashOf(module); }
+
+auto ModuleInit::hash() const -> size_t { return meta::hashRange(nodes, meta::hashOf(module)); }
+
+auto VariableInit::hash() const -> size_t { return meta::hashRange(nodes, meta::hashOf(variable)); }
+
+auto InitExpr::hash() const -> size_t { return hashVariant(*this); }
+
+auto NameTypeValueTuple::hash() const -> size_t { return meta::hashRange(*tuple); }
+
+auto ScopedBlockLiteral::hash() const -> size_t { return meta::hashOf(block); }
+
+auto ValueExpr::hash() const -> size_t { return hashVariant(*this); }
+
+auto BlockExpr::hash() const -> size_t { return hashVariant(*this); }
+
+auto PartiallyParsed::hash() const -> size_t { return hashVariant(*this); }
+
+auto NameTypeValue::hash() const -> size_t {
+    auto h = hashNode(name);
+    h = meta::hashCombine(h, hashNode(type));
+    return meta::hashCombine(h, hashNode(value));
+}
+
 } // namespace parser
@@ -7,6 +7,7 @@
 
 #include "text/Range.h"
 
+#include "meta/CopyOnWrite.h"
 #include "meta/Variant.h"
 
 #include <list>
@@ -40,6 +41,7 @@ struct Block {
 
     bool operator==(const This& o) const { return expressions == o.expressions; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t; ///< structural hash (equal nodes have equal hashes)
 };
 static_assert(meta::has_move_assignment<Block>);
 
@@ -58,6 +60,7 @@ struct NameTypeValueReference {
 
     bool operator==(const This& o) const;
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<NameTypeValueReference>);
 
@@ -68,6 +71,7 @@ struct VariableReference {
 
     bool operator==(const This& o) const { return variable == o.variable; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<VariableReference>);
 
@@ -78,6 +82,7 @@ struct TypeReference {
 
     bool operator==(const This& o) const { return type == o.type; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<TypeReference>);
 
@@ -94,6 +99,7 @@ struct ArgumentAssignment {
 
     bool operator==(const This& o) const { return parameter == o.parameter && values == o.values; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 using ArgumentAssignments = std::vector<ArgumentAssignment>;
 static_assert(meta::has_move_assignment<ArgumentAssignment>);
@@ -107,6 +113,7 @@ struct Call {
 
     bool operator==(const This& o) const { return function == o.function && arguments == o.arguments; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<Call>);
 
@@ -128,6 +135,8 @@ constexpr auto type_expr_pack = //
 using TypeExprVariant = meta::ApplyPack<meta::Variant, decltype(type_expr_pack)>;
 struct TypeExpr : TypeExprVariant {
     META_VARIANT_CONSTRUCT(TypeExpr, TypeExprVariant)
+
+    auto hash() const -> size_t;
 };
 using OptTypeExpr = meta::Optional<TypeExpr>;
 using TypeExprView = const TypeExpr*;
@@ -140,6 +149,7 @@ struct ModuleReference {
 
     bool operator==(const This& o) const { return module == o.module; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<ModuleReference>);
 
@@ -157,6 +167,7 @@ struct ModuleInit {
 
     bool operator==(const This& o) const { return module == o.module && nodes == o.nodes; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<ModuleInit>);
 
@@ -168,6 +179,7 @@ struct VariableInit {
 
     bool operator==(const This& o) const { return variable == o.variable && nodes == o.nodes; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<VariableInit>);
 
@@ -179,16 +191,23 @@ constexpr auto init_expr_pack = meta::type_pack<
 using InitExprVariant = meta::ApplyPack<meta::Variant, decltype(init_expr_pack)>;
 struct InitExpr : InitExprVariant {
     META_VARIANT_CONSTRUCT(InitExpr, InitExprVariant)
+
+    auto hash() const -> size_t;
 };
 
-/// wrapper for ListOfNameTypeValue
-// TODO: remove if we do not add functionality here
+/// ListOfNameTypeValue with shared storage
+// copies are cheap (eg. storing in the machine) - use tuple.modify() to change the list
 struct NameTypeValueTuple {
     using This = NameTypeValueTuple;
-    ListOfNameTypeValue tuple{};
+    meta::CopyOnWrite<ListOfNameTypeValue> tuple{};
+
+    NameTypeValueTuple() = default;
+    explicit NameTypeValueTuple(ListOfNameTypeValue list)
+        : tuple(std::move(list)) {}
 
-    bool operator==(const This& o) const { return tuple == o.tuple; }
+    bool operator==(const This& o) const { return tuple.isSame(o.tuple) || *tuple == *o.tuple; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<NameTypeValueTuple>);
 
@@ -201,6 +220,7 @@ struct ScopedBlockLiteral {
 
     bool operator==(const This& o) const { return block == o.block; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 
 using nesting::IdentifierLiteral;
@@ -216,6 +236,8 @@ constexpr auto value_expr_pack = //
 using ValueExprVariant = meta::ApplyPack<meta::Variant, decltype(value_expr_pack)>;
 struct ValueExpr : public ValueExprVariant {
     META_VARIANT_CONSTRUCT(ValueExpr, ValueExprVariant)
+
+    auto hash() const -> size_t;
 };
 using OptValueExpr = meta::Optional<ValueExpr>;
 using ValueExprView = const ValueExpr*;
@@ -233,6 +255,8 @@ constexpr auto block_expr_pack = //
 using BlockExprVariant = meta::ApplyPack<meta::Variant, decltype(block_expr_pack)>;
 struct BlockExpr : public BlockExprVariant {
     META_VARIANT_CONSTRUCT(BlockExpr, BlockExprVariant)
+
+    auto hash() const -> size_t;
 };
 using OptBlockExpr = meta::Optional<BlockExpr>;
 
@@ -243,6 +267,8 @@ static_assert(meta::has_move_assignment<PartiallyParsedVariant>);
 
 struct PartiallyParsed : public PartiallyParsedVariant {
     META_VARIANT_CONSTRUCT(PartiallyParsed, PartiallyParsedVariant)
+
+    auto hash() const -> size_t;
 };
 static_assert(meta::has_move_assignment<PartiallyParsed>);
 
@@ -256,6 +282,7 @@ struct NameTypeValue {
 
     bool operator==(const This& o) const { return name == o.name && type == o.type && value == o.value; }
     bool operator!=(const This& o) const { return !(*this == o); }
+    auto hash() const -> size_t;
 };
 using OptNameTypeValue = meta::Optional<meta::DefaultPacked<NameTypeValue>>;
 using OptNameTypeValueView = meta::Optional<meta::DefaultPacked<NameTypeValueView>>;
@@ -3,6 +3,8 @@
 
 #include "meta/Optional.h"
 
+#include <unordered_map>
+
 #if !defined(VALUE_DEBUG_DATA)
 #    if defined(_DEBUG)
 #        define VALUE_DEBUG_DATA
@@ -21,10 +23,14 @@ using ConstructFunc = void(void* dest);
 using DestructFunc = void(void* dest);
 using CloneFunc = void(void* dest, const void* source);
 using EqualFunc = bool(const void*, const void*);
+using HashFunc = size_t(const void*);
 #ifdef VALUE_DEBUG_DATA
 using DebugDataFunc = auto(std::ostream& out, const void*) -> std::ostream&;
 #endif
 
+struct Type;
+using ImplicitFromMap = std::unordered_map<const Type*, instance::FunctionView>;
+
 enum class TypeParser {
     Expression,
     SingleToken,
@@ -39,12 +45,28 @@ struct Type {
     DestructFunc* destructFunc{};
     CloneFunc* cloneFunc{};
     EqualFunc* equalFunc{};
+    HashFunc* hashFunc{}; ///< optional - values of types without hash share one bucket
     TypeParser typeParser{};
+    bool trivial{}; ///< trivially copyable and equal exactly if the bytes are equal - allows memcpy and memcmp
 #ifdef VALUE_DEBUG_DATA
     DebugDataFunc* debugDataFunc{};
 #endif
+    // note: only intrinsic conversions are declared here, while their module is built - never changed once shared
+    // user conversions are looked up in their scope
+    mutable ImplicitFromMap implicitFrom{}; ///< conversion functions by source type
 };
 using TypeView = const Type*;
 using OptTypeView = meta::Optional<TypeView>;
 
+/// registers a function that converts values of type from into values of type to
+inline void declareImplicitFrom(TypeView from, TypeView to, instance::FunctionView function) {
+    to->implicitFrom[from] = function;
+}
+
+/// the intrinsic function that converts values of type from into values of type to - nullptr if none was declared
+inline auto implicitFrom(TypeView from, TypeView to) -> instance::FunctionView {
+    auto it = to->implicitFrom.find(from);
+    return it != to->implicitFrom.end() ? it->second : nullptr;
+}
+
 } // namespace parser
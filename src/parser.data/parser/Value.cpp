@@ -2,6 +2,7 @@
 
 namespace parser {
 
-// empty
+const meta::EventCounter valueAllocations{"Value.allocate"};
+const meta::EventCounter valueClones{"Value.clone"};
 
 } // namespace parser
@@ -1,70 +1,62 @@
 #pragma once
 #include "Type.h"
 
+#include "meta/EventCounter.h"
+#include "meta/Hash.h"
 #include "meta/Type.h"
 #include "meta/TypeTraits.h"
 
+#include <atomic>
+#include <memory>
+
 namespace parser {
 
+extern const meta::EventCounter valueAllocations; ///< payloads constructed for a type
+extern const meta::EventCounter valueClones; ///< payloads cloned by copy on write
+
+/// type erased value
+// copies share the payload - it is cloned on the first mutable access (copy on write)
 struct Value {
     using This = Value;
 
     Value() = default;
     explicit Value(TypeView type)
         : m_type(type)
-        , m_storage(m_type ? new uint8_t[type->size] : nullptr) {
-        if (m_type) m_type->constructFunc(data());
-    }
-    ~Value() { destruct(); }
-
-    Value(const This& o)
-        : m_type(o.m_type)
-        , m_storage(m_type ? new uint8_t[o.m_type->size] : nullptr) {
-        if (m_type) m_type->cloneFunc(data(), o.data());
-    }
-    auto operator=(const This& o) -> This& {
-        if (m_type != nullptr) {
-            if (m_storage) m_type->destructFunc(data());
-            if (o.m_type == nullptr) {
-                m_storage.reset(nullptr);
-                m_type = nullptr;
-            }
-            else {
-                if (m_type != o.m_type) {
-                    m_type = o.m_type;
-                    if (m_type->size != o.m_type->size) m_storage.reset(new uint8_t[o.m_type->size]);
-                }
-                m_type->cloneFunc(data(), o.data());
-            }
-        }
-        else if (m_type != nullptr) {
-            m_type = o.m_type;
-            m_storage.reset(new uint8_t[o.m_type->size]);
-            m_type->cloneFunc(data(), o.data());
-        }
-        return *this;
-    }
-
-    Value(This&& o) noexcept
-        : m_type(o.m_type)
-        , m_storage(o.m_storage.release()) {}
-
-    auto operator=(This&& o) noexcept -> This& {
-        destruct();
-        m_type = o.m_type;
-        m_storage = std::move(o.m_storage);
-        return *this;
-    }
+        , m_storage(createStorage(type)) {}
 
     [[nodiscard]] bool operator==(const This& o) const {
-        return m_type == o.m_type && (m_type == nullptr || m_type->equalFunc(data(), o.data()));
+        if (m_type != o.m_type) return false;
+        if (m_storage == o.m_storage) return true; // shared payload (copies)
+        auto hash = m_hash.load(), otherHash = o.m_hash.load();
+        if (hash != 0 && otherHash != 0 && hash != otherHash) return false; // fast path
+        return m_type == nullptr || m_type->equalFunc(data(), o.data());
     }
     [[nodiscard]] bool operator!=(const This& o) const { return !(*this == o); }
 
+    /// structural hash - cached until the value is accessed mutably
+    // racing threads compute the same hash, so the cache is a relaxed atomic
+    [[nodiscard]] auto hash() const -> size_t {
+        auto hash = m_hash.load();
+        if (hash == 0) {
+            auto payload = m_type && m_type->hashFunc ? m_type->hashFunc(data()) : size_t{};
+            hash = meta::hashCombine(meta::hashOf(m_type), payload);
+            m_hash.store(hash);
+        }
+        return hash;
+    }
+
     [[nodiscard]] auto type() const& -> TypeView { return m_type; }
 
     [[nodiscard]] auto data() const& -> const void* { return m_storage.get(); }
-    [[nodiscard]] auto data() & -> void* { return m_storage.get(); }
+    // a sole owner writes in place - the fence pairs with the release of the last copy on another thread
+    [[nodiscard]] auto data() & -> void* {
+        if (m_storage.use_count() > 1)
+            m_storage = createStorage(m_type, m_storage.get());
+        else
+            std::atomic_thread_fence(std::memory_order_acquire);
+        m_hash.store(0);
+        return m_storage.get();
+    }
 
     template<class T>
     [[nodiscard]] auto get(meta::Type<T> = {}) const& -> const T& {
@@ -80,11 +72,48 @@ struct Value {
     }
 
 private:
+    friend struct ValueArena;
+    using Storage = std::shared_ptr<uint8_t>;
+
+    Value(TypeView type, Storage storage)
+        : m_type(type)
+        , m_storage(std::move(storage)) {}
+
+    /// copyable relaxed atomic - 0 = not computed yet
+    struct CachedHash {
+        std::atomic<size_t> v{};
+
+        CachedHash() = default;
+        CachedHash(const CachedHash& o) noexcept
+            : v(o.load()) {}
+        auto operator=(const CachedHash& o) noexcept -> CachedHash& {
+            store(o.load());
+            return *this;
+        }
+
+        [[nodiscard]] auto load() const noexcept -> size_t { return v.load(std::memory_order_relaxed); }
+        void store(size_t h) noexcept { v.store(h, std::memory_order_relaxed); }
+    };
+
     TypeView m_type{};
-    std::unique_ptr<uint8_t[]> m_storage{};
+    Storage m_storage{};
+    mutable CachedHash m_hash{};
 
-    void destruct() noexcept {
-        if (m_type && m_storage) m_type->destructFunc(data());
+    static auto createStorage(TypeView type, const void* source = nullptr) -> Storage {
+        if (type == nullptr) return {};
+        auto memory = std::unique_ptr<uint8_t[]>(new uint8_t[type->size]);
+        if (source) {
+            valueClones.add();
+            type->cloneFunc(memory.get(), source);
+        }
+        else {
+            valueAllocations.add();
+            type->constructFunc(memory.get());
+        }
+        return Storage{memory.release(), [type](uint8_t* data) {
+                           type->destructFunc(data);
+                           delete[] data;
+                       }};
     }
 };
 static_assert(meta::has_move_assignment<Value>);
@@ -0,0 +1,55 @@
+#include "ValueArena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace parser {
+
+namespace {
+
+auto alignmentOf(TypeView type) -> size_t { return std::max<size_t>(type->alignment, 1); }
+auto alignUp(size_t offset, size_t alignment) -> size_t { return (offset + alignment - 1) / alignment * alignment; }
+
+} // namespace
+
+ValueArena::ValueArena(size_t size, size_t alignment)
+    : m_memory(static_cast<std::byte*>(::operator new(size, std::align_val_t{alignment})))
+    , m_size(size)
+    , m_alignment(alignment) {}
+
+ValueArena::~ValueArena() {
+    std::for_each(m_placed.rbegin(), m_placed.rend(), [](const auto& placed) {
+        placed.first->destructFunc(placed.second);
+    });
+    ::operator delete(m_memory, std::align_val_t{m_alignment});
+}
+
+auto ValueArena::place(const Values& values) -> Placed {
+    auto size = size_t{};
+    auto alignment = alignof(std::max_align_t);
+    for (const auto& value : values) {
+        if (value.type() == nullptr) continue;
+        size = alignUp(size, alignmentOf(value.type())) + value.type()->size;
+        alignment = std::max(alignment, alignmentOf(value.type()));
+    }
+    auto arena = std::make_shared<ValueArena>(std::max<size_t>(size, 1), alignment);
+    auto placed = Values{};
+    placed.reserve(values.size());
+    auto offset = size_t{};
+    for (const auto& value : values) {
+        const auto type = value.type();
+        if (type == nullptr) {
+            placed.push_back(value);
+            continue;
+        }
+        offset = alignUp(offset, alignmentOf(type));
+        auto* memory = arena->m_memory + offset;
+        type->cloneFunc(memory, value.data());
+        arena->m_placed.emplace_back(type, memory);
+        offset += type->size;
+        placed.push_back(Value{type, Value::Storage{arena, reinterpret_cast<uint8_t*>(memory)}});
+    }
+    return Placed{std::move(arena), std::move(placed)};
+}
+
+} // namespace parser
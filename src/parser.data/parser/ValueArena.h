@@ -0,0 +1,47 @@
+#pragma once
+#include "Value.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace parser {
+
+/// one contiguous allocation for the payloads of many values
+// every value placed here keeps the whole arena alive - the last one destructs all payloads
+// copies are written on mutable access, so placed payloads never change while they are shared
+struct ValueArena {
+    using This = ValueArena;
+    using Values = std::vector<Value>;
+    struct Placed;
+
+    /// copies of values (same order) with all payloads in one new arena
+    [[nodiscard]] static auto place(const Values& values) -> Placed;
+
+    /// true if the payload of value lives in this arena
+    [[nodiscard]] auto contains(const Value& value) const -> bool {
+        const auto* p = static_cast<const std::byte*>(value.data());
+        return !std::less<>{}(p, m_memory) && std::less<>{}(p, m_memory + m_size);
+    }
+
+    explicit ValueArena(size_t size, size_t alignment);
+    ~ValueArena();
+
+    ValueArena(const This&) = delete;
+    auto operator=(const This&) -> This& = delete;
+
+private:
+    std::byte* m_memory{};
+    size_t m_size{};
+    size_t m_alignment{};
+    std::vector<std::pair<TypeView, void*>> m_placed{}; // in order of construction
+};
+
+struct ValueArena::Placed {
+    std::shared_ptr<const ValueArena> arena{};
+    Values values{};
+};
+
+} // namespace parser
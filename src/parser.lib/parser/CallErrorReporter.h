@@ -21,6 +21,11 @@ struct CallErrorReporter {
                 instance::TypeView,
                 decltype(std::declval<T>().intrinsicType(std::declval<meta::Type<StringLiteral>>()))>,
             "no intrinsicType");
+        static_assert(
+            std::is_same_v<
+                instance::ConstEntryRange,
+                decltype(std::declval<T>().lookup(std::declval<strings::View>()))>,
+            "no lookup");
         static_assert(
             std::is_same_v<void, decltype(std::declval<T>().reportDiagnostic(std::declval<diagnostic::Diagnostic>()))>,
             "no reportDiagnostic");
@@ -31,6 +36,8 @@ struct CallErrorReporter {
                     std::declval<T>().parserForType(std::declval<const TypeView&>()) //
                     (std::declval<BlockLineView&>()))>,
             "no parserForType");
+        static_assert(
+            std::is_same_v<OptValueExpr, decltype(std::declval<T>().runCall(std::declval<Call>()))>, "no runCall");
         static_assert(
             std::is_same_v<
                 OptNameTypeValue,
@@ -43,8 +50,13 @@ struct CallErrorReporter {
             return api.intrinsicType(meta::type<Type>);
         }
 
+        auto lookup(strings::View view) -> instance::ConstEntryRange { return api.lookup(view); }
+        auto lookupImplicitFrom(TypeView from, TypeView to) -> instance::FunctionView {
+            return api.lookupImplicitFrom(from, to);
+        }
         void reportDiagnostic(diagnostic::Diagnostic diagnostic) { api.reportDiagnostic(std::move(diagnostic)); }
         auto parserForType(const TypeView& type) { return api.parserForType(type); }
+        auto runCall(Call call) -> OptValueExpr { return api.runCall(std::move(call)); }
 
         template<class Callback>
         auto parseNtvWithCallback(BlockLineView& it, Callback&& cb) -> OptNameTypeValue {
@@ -79,13 +91,41 @@ struct CallErrorReporter {
                      ? String{"A call with opening bracket is expected to close before the end of the line."}
                      : String{"An closing bracket for the call was expected here."},
                  {}},
-             SourceCodeBlock{escapedLines, highlights, String{}, line}}};
+             SourceCodeBlock{escapedLines, highlights, String{}, line, source}}};
 
         auto expl = Explanation{String("Missing Closing Bracket"), doc};
 
         auto d = Diagnostic{Code{String{"rebuild-call"}, 1}, Parts{expl}};
         external.reportDiagnostic(std::move(d));
     }
+
+    template<class T>
+    static void reportFailedConversion(const BlockLineView& begin, const BlockLineView& end, External<T>& external) {
+        using namespace diagnostic;
+
+        auto* blockLine = begin.line();
+        auto source = extractBlockLines(*blockLine);
+        auto first = begin.current().visit([](auto& t) { return t.input; });
+        auto last = first;
+        for (auto it = begin; it != end && it; ++it) last = it.current().visit([](auto& t) { return t.input; });
+        auto line = begin.current().visit([](auto& t) { return t.position.line; });
+        auto viewMarkers = ViewMarkers{};
+        viewMarkers.emplace_back(View{first.begin(), last.end()});
+
+        auto [escapedLines, escapedMarkers] = escapeSourceLine(source, viewMarkers);
+
+        auto highlights = Highlights{};
+        for (auto& m : escapedMarkers) highlights.emplace_back(Marker{m, {}});
+
+        auto doc = Document{
+            {Paragraph{String{"The argument could not be converted to the type of the parameter."}, {}},
+             SourceCodeBlock{escapedLines, highlights, String{}, line, source}}};
+
+        auto expl = Explanation{String("Failed Conversion"), doc};
+
+        auto d = Diagnostic{Code{String{"rebuild-call"}, 2}, Parts{expl}};
+        external.reportDiagnostic(std::move(d));
+    }
 };
 
 } // namespace parser
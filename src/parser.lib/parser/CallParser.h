@@ -11,6 +11,28 @@ using instance::FunctionView;
 using instance::OptParameterView;
 using instance::ParameterView;
 
+/// type of a value that is known while parsing - nullptr otherwise
+inline auto parsedType(const ValueExpr& value) -> TypeView {
+    return value.holds<Value>() ? value.get<Value>().type() : nullptr;
+}
+
+/// the function that converts values of type from into values of type to - nullptr if none is visible
+// user conversions are indexed by the scope that declares them - they only apply where their module is visible
+// intrinsic conversions are declared on their target type
+template<class Context>
+auto findImplicitFrom(TypeView from, TypeView to, Context& context) -> FunctionView {
+    if (auto function = context.lookupImplicitFrom(from, to); function) return function;
+    return implicitFrom(from, to);
+}
+
+/// true if the value matches the type or a conversion is visible
+// note: without type inference only literal values are checked
+template<class Context>
+bool isImplicitConvertible(const ValueExpr& value, TypeView to, Context& context) {
+    auto from = parsedType(value);
+    return !from || !to || from == to || findImplicitFrom(from, to, context) != nullptr;
+}
+
 struct CallOverloads {
     struct Item {
         FunctionView function{};
@@ -29,7 +51,26 @@ struct CallOverloads {
             , complete(function->parameters.empty()) {}
     };
     using Items = std::vector<Item>;
+
+    /// argument value parsed at one token position
+    struct ParsedArgument {
+        size_t index{}; // token position where parsing started
+        TypeParser parser{};
+        TypeView type{};
+        OptValueExpr value{};
+        BlockLineView end{}; // position after the argument
+    };
+    using ParsedArguments = std::vector<ParsedArgument>;
+
+    /// argument of an item whose implicit conversion failed
+    struct FailedConversion {
+        BlockLineView begin{};
+        BlockLineView end{};
+    };
+
     Items items{};
+    ParsedArguments parsedArguments{}; // shared by all items, so each span is parsed (and executed) once
+    meta::Optional<FailedConversion> failedConversion{}; // reported only if no item completes
     int sideEffects{}; // the total side effects that were created during parsing
     bool tainted{}; // true if error was already reported
 
@@ -52,7 +93,7 @@ struct CallParser {
     template<class T>
     static void parse(CallOverloads& os, BlockLineView& it, T t) {
         auto external = External<T>{t};
-        auto withBrackets = it.current().holds<nesting::BracketOpen>();
+        auto withBrackets = it && it.current().holds<nesting::BracketOpen>();
         if (withBrackets) {
             auto& open = it.current().get<nesting::BracketOpen>();
             ++it; // skip BracketOpen
@@ -96,19 +137,28 @@ private:
         if (ntv.type || !ntv.value) {
             return isNameTypeValue(parameter->variable->type, external);
         }
-        // TODO(arBmind): allow real conversions
-        return ntv.value ? true : false;
+        return isImplicitConvertible(ntv.value.value(), parameter->variable->type, external);
     }
+    // literal values are converted right away - nothing is returned if the conversion failed
     template<class T>
-    static auto implicitConvert(const NameTypeValue& ntv, ParameterView /*parameter*/, External<T>& external)
-        -> VecOfValueExpr {
+    static auto implicitConvert(const NameTypeValue& ntv, ParameterView parameter, External<T>& external)
+        -> meta::Optional<VecOfValueExpr> {
         if (ntv.type || !ntv.value) {
             auto type = external.intrinsicType(meta::Type<NameTypeValue>{});
             auto value = Value(type);
             value.set<NameTypeValue>() = ntv;
-            return {std::move(value)};
+            return VecOfValueExpr{std::move(value)};
         }
-        return {ntv.value.value()};
+        const auto& value = ntv.value.value();
+        auto from = parsedType(value);
+        auto to = parameter->variable->type;
+        if (!from || !to || from == to) return VecOfValueExpr{value};
+        const auto* function = findImplicitFrom(from, to, external);
+        if (!function) return {};
+        auto call = Call{function, {ArgumentAssignment{function->rightParameters()[0].get(), {value}}}};
+        auto converted = external.runCall(std::move(call));
+        if (!converted) return {};
+        return VecOfValueExpr{std::move(converted).value()};
     }
 
     static void parseOptionalComma(BlockLineView& it) {
@@ -167,34 +217,46 @@ private:
                 item.active = false;
             }
         };
-        auto assignParam = [&](ItemIt& itemIt, BlockLineView& it, const NameTypeValue& nameTypeValue) {
+        auto parseArgument = [&](BlockLineView& it, const TypeView& type, bool& parsed) -> OptValueExpr {
+            auto parser = type ? type->typeParser : TypeParser::Expression;
+            for (const auto& p : os.parsedArguments) {
+                if (p.index == it.index() && p.parser == parser && p.type == type) {
+                    it = p.end;
+                    return p.value;
+                }
+            }
+            auto index = it.index();
+            auto value = external.parserForType(type)(it);
+            os.parsedArguments.push_back({index, parser, type, value, it});
+            parsed = true;
+            return value;
+        };
+        auto assignParam = [&](ItemIt& itemIt, BlockLineView& it, const NameTypeValue& nameTypeValue, bool parsed) {
             bool sideEffect = hasSideEffects(nameTypeValue);
-            if (sideEffect) os.sideEffects++;
-            auto allowMismatch = bool{};
-            auto baseIt = itemIt->it;
+            if (sideEffect && parsed) os.sideEffects++;
             auto isNamed = nameTypeValue.name && !nameTypeValue.type;
-            while (true) {
-                auto optParam = isNamed ? paramByName(itemIt, nameTypeValue.name.value()) : paramByPos(itemIt);
-                if (optParam && canImplicitConvert(nameTypeValue, optParam.value(), external)) {
-                    auto param = optParam.value();
-                    auto as = ArgumentAssignment{};
-                    as.parameter = param;
-                    as.values = implicitConvert(nameTypeValue, param, external);
-                    itemIt->args.push_back(std::move(as));
-                    itemIt->it = it;
-                    itemIt->argIndex = isNamed && paramByPos(itemIt) != optParam ? -1 : (itemIt->argIndex + 1);
-                    if (sideEffect) itemIt->sideEffects++;
-                    if (isNodeBlockLiteral(nameTypeValue.value, external)) itemIt->hasBlocks = true;
-                    updateStatus(*itemIt);
-                    if (itemIt->active) parseOptionalComma(itemIt->it);
-                }
-                else if (!allowMismatch) {
-                    itemIt->active = false;
-                }
-
-                allowMismatch = true;
-                if (!skipItem(itemIt, baseIt)) return;
+            auto optParam = isNamed ? paramByName(itemIt, nameTypeValue.name.value()) : paramByPos(itemIt);
+            if (!optParam || !canImplicitConvert(nameTypeValue, optParam.value(), external)) {
+                itemIt->active = false;
+                return;
             }
+            auto param = optParam.value();
+            auto values = implicitConvert(nameTypeValue, param, external);
+            if (!values) {
+                if (!os.failedConversion) os.failedConversion = CallOverloads::FailedConversion{itemIt->it, it};
+                itemIt->active = false;
+                return;
+            }
+            auto as = ArgumentAssignment{};
+            as.parameter = param;
+            as.values = std::move(values).value();
+            itemIt->args.push_back(std::move(as));
+            itemIt->it = it;
+            itemIt->argIndex = isNamed && paramByPos(itemIt) != optParam ? -1 : (itemIt->argIndex + 1);
+            if (sideEffect) itemIt->sideEffects++;
+            if (isNodeBlockLiteral(nameTypeValue.value, external)) itemIt->hasBlocks = true;
+            updateStatus(*itemIt);
+            if (itemIt->active) parseOptionalComma(itemIt->it);
         };
 
         while (true) {
@@ -204,19 +266,19 @@ private:
             auto next = nextItem();
             auto nextIt = next->it;
 
+            auto parsed = false;
             auto parseValue = [&](NameTypeValue& ntv) {
                 auto optParam =
                     (ntv.name && !ntv.type) ? scanParamByName(next, ntv.name.value()) : scanParamByPos(next);
                 if (optParam) {
-                    auto parseArg = external.parserForType(optParam.value()->variable->type);
-                    ntv.value = parseArg(nextIt);
+                    ntv.value = parseArgument(nextIt, optParam.value()->variable->type, parsed);
                 }
                 // invalid Param cannot be parsed
             };
             auto optNtv = external.parseNtvWithCallback(nextIt, parseValue);
             if (next == active) continue; // no params matched
             if (optNtv) {
-                assignParam(next, nextIt, optNtv.value());
+                assignParam(next, nextIt, optNtv.value(), parsed);
             }
             else {
                 next->active = false;
@@ -225,6 +287,11 @@ private:
         startIt =
             std::max_element(itemBegin, itemEnd, [](auto& l, auto& r) { return l.it.index() < r.it.index(); })->it;
         std::stable_partition(itemBegin, itemEnd, [](auto& o) { return o.complete; });
+        if (os.failedConversion && os.countComplete() == 0 && !os.tainted) {
+            const auto& failed = os.failedConversion.value();
+            CallErrorReporter::reportFailedConversion(failed.begin, failed.end, external);
+            os.tainted = true;
+        }
     }
 };
 
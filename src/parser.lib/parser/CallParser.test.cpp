@@ -11,6 +11,7 @@
 #include "instance/Function.builder.h"
 #include "instance/Function.ostream.h"
 #include "instance/Scope.builder.h"
+#include "instance/ScopeLookup.h"
 #include "instance/Type.builder.h"
 
 #include "diagnostic/Diagnostic.ostream.h"
@@ -46,11 +47,14 @@ struct TestCallExternal {
     ValueNodes valueNodes{};
     IndexNtvs indexNtvs{};
     std::string diagnostics{};
+    int* valueParses{}; // counts calls of the value parsers (the external is copied)
 
     template<class Type>
     auto intrinsicType(meta::Type<Type>) -> instance::TypeView {
         return {};
     }
+    auto lookup(strings::View) -> instance::ConstEntryRange { return {}; }
+    auto lookupImplicitFrom(TypeView, TypeView) -> instance::FunctionView { return nullptr; }
     void reportDiagnostic(diagnostic::Diagnostic diagnostic) {
         auto stream = std::stringstream{};
         stream << diagnostics << '\n';
@@ -58,9 +62,12 @@ struct TestCallExternal {
         diagnostics = stream.str();
     }
 
+    auto runCall(Call) -> OptValueExpr { return {}; }
+
     auto parserForType(const TypeView& type) {
         return [this, type](BlockLineView& blv) -> OptValueExpr {
             if (!blv) return {};
+            if (valueParses) ++*valueParses;
             auto k = [&] {
                 auto ks = std::stringstream{};
                 ks << '[' << blv.index() << ']' << *type;
@@ -246,3 +253,72 @@ INSTANTIATE_TEST_CASE_P(
                 .complete(1);
         }()),
     [](const ::testing::TestParamInfo<CallParserData>& inf) { return inf.param.name; });
+
+TEST(CallParser, sharedArgument) {
+    auto data = CallParserData("SharedArgument") //
+                    .ctx( //
+                        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+                        instance::fun("print").runtime().params(instance::param("v").right().type(type("NumLit"))),
+                        instance::fun("print").runtime().params(instance::param("w").right().type(type("NumLit"))),
+                        instance::fun("print").runtime().params(
+                            instance::param("v").right().type(type("NumLit")),
+                            instance::param("w").right().type(type("NumLit"))))
+                    .in(nesting::num("1"))
+                    .load("print")
+                    .indexNtv(0, parser::ntv())
+                    .value("[0]:NumLit", parser::valueExpr(nesting::num("1")).typeName("NumLit"));
+
+    auto ext = TestCallExternal{};
+    ext.indexNtvs = data.indexNtvs;
+    ext.valueNodes = data.valueNodes;
+    auto valueParses = 0;
+    ext.valueParses = &valueParses;
+
+    auto os = CallOverloads{};
+    for (auto& fv : data.functions) os.items.emplace_back(fv);
+
+    auto it = BlockLineView{&data.input};
+    parser::CallParser::parse(os, it, ext);
+
+    EXPECT_EQ(valueParses, 1); // all three overloads share the parsed argument
+    EXPECT_EQ(os.countComplete(), 2);
+}
+
+// a failed conversion is not reported if another overload takes the argument
+TEST(CallParser, failedConversionOfOtherOverload) {
+    auto data = CallParserData("FailedConversion") //
+                    .ctx( //
+                        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+                        instance::typeModT<uint64_t>("u64"),
+                        instance::fun("fromLiteral")
+                            .compiletime()
+                            .params(
+                                instance::param("literal").right().type(type("NumLit")),
+                                instance::param("result").result().type(type("u64"))),
+                        instance::fun("print").runtime().params(instance::param("v").right().type(type("u64"))),
+                        instance::fun("print").runtime().params(instance::param("v").right().type(type("NumLit"))))
+                    .in(nesting::num("99999999999999999999"))
+                    .load("print")
+                    .indexNtv(0, parser::ntv())
+                    .value("[0]:u64", parser::valueExpr(nesting::num("99999999999999999999")).typeName("NumLit"))
+                    .value("[0]:NumLit", parser::valueExpr(nesting::num("99999999999999999999")).typeName("NumLit"));
+    const auto* numLit = instance::lookupA<instance::TypePtr>(*data.scope, View{"NumLit"}).get();
+    const auto* u64 = instance::lookupA<instance::TypePtr>(*data.scope, View{"u64"}).get();
+    const auto& fromLiteral = instance::lookupA<instance::FunctionPtr>(*data.scope, View{"fromLiteral"});
+    parser::declareImplicitFrom(numLit, u64, fromLiteral.get()); // runCall fails - the literal is out of range
+
+    auto ext = TestCallExternal{};
+    ext.indexNtvs = data.indexNtvs;
+    ext.valueNodes = data.valueNodes;
+
+    auto os = CallOverloads{};
+    for (auto& fv : data.functions) os.items.emplace_back(fv);
+
+    auto it = BlockLineView{&data.input};
+    parser::CallParser::parse(os, it, ext);
+
+    ASSERT_EQ(os.countComplete(), 1);
+    EXPECT_EQ(os.items.front().function->parameters[0]->variable->type, numLit);
+    EXPECT_FALSE(os.tainted);
+    EXPECT_EQ(ext.diagnostics, std::string{});
+}
@@ -0,0 +1,90 @@
+#include "parser/ConstantPool.h"
+
+#include "instance/Type.builder.h"
+#include "nesting/Token.builder.h"
+#include "nesting/Token.ostream.h"
+
+#include "gtest/gtest.h"
+
+#include <utility>
+
+using namespace parser;
+
+namespace {
+
+auto typeOf(const instance::ModulePtr& mod) -> TypeView {
+    return mod->locals.byName(strings::View{"type"}).frontValue().get<instance::TypePtr>().get();
+}
+
+} // namespace
+
+TEST(constantPool, shared) {
+    const auto mod = instance::typeModT<nesting::NumberLiteral>("NumLit").build();
+    const auto type = typeOf(mod);
+    auto pool = ConstantPool{};
+
+    auto one = nesting::num("1");
+    auto otherOne = nesting::num("1");
+    otherOne.position = text::Position{text::Line{2}, text::Column{5}};
+
+    const auto a = pool.intern(type, one);
+    const auto b = pool.intern(type, otherOne);
+    const auto c = pool.intern(type, nesting::num("2"));
+
+    ASSERT_EQ(a.data(), b.data()); // one shared payload
+    ASSERT_NE(a.data(), c.data());
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_EQ(a.get<nesting::NumberLiteral>().value, one.value);
+    ASSERT_EQ(a.get<nesting::NumberLiteral>().input, strings::View{}); // locations stay with the tokens
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_EQ(pool.reused(), 1u);
+
+    const auto before = meta::readEventCounts();
+    ASSERT_EQ(a, pool.intern(type, otherOne));
+    ASSERT_EQ((meta::readEventCounts() - before)[valueAllocations], 0u); // repeated literals allocate nothing
+}
+
+TEST(constantPool, copyOnWrite) {
+    const auto mod = instance::typeModT<nesting::NumberLiteral>("NumLit").build();
+    const auto type = typeOf(mod);
+    auto pool = ConstantPool{};
+
+    const auto a = pool.intern(type, nesting::num("1"));
+    auto b = a;
+    b.set<nesting::NumberLiteral>().value.integerPart += strings::View{"2"};
+
+    ASSERT_NE(a.data(), b.data());
+    ASSERT_NE(a, b);
+    ASSERT_EQ(pool.intern(type, nesting::num("1")), a); // pool is unchanged
+}
+
+TEST(constantPool, freeze) {
+    const auto mod = instance::typeModT<nesting::NumberLiteral>("NumLit").build();
+    const auto type = typeOf(mod);
+    auto pool = ConstantPool{};
+
+    auto one = pool.intern(type, nesting::num("1"));
+    auto two = pool.intern(type, nesting::num("2"));
+    const auto* oldOne = std::as_const(one).data();
+
+    const auto relocation = pool.freeze();
+    ASSERT_NE(pool.arena(), nullptr);
+    ASSERT_EQ(std::as_const(one).data(), oldOne); // copies stay valid until they are rebased
+
+    relocation.rebase(one);
+    relocation.rebase(two);
+    EXPECT_NE(std::as_const(one).data(), oldOne);
+    EXPECT_TRUE(pool.arena()->contains(one));
+    EXPECT_TRUE(pool.arena()->contains(two));
+    EXPECT_EQ(one.get<nesting::NumberLiteral>().value, nesting::num("1").value);
+
+    const auto before = meta::readEventCounts();
+    EXPECT_EQ(pool.intern(type, nesting::num("2")).data(), std::as_const(two).data()); // later literals share the arena
+    EXPECT_EQ((meta::readEventCounts() - before)[valueAllocations], 0u);
+
+    auto changed = one;
+    changed.set<nesting::NumberLiteral>().value.integerPart += strings::View{"2"};
+    EXPECT_FALSE(pool.arena()->contains(changed)); // the arena is never written
+    EXPECT_EQ(one.get<nesting::NumberLiteral>().value, nesting::num("1").value);
+}
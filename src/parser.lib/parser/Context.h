@@ -28,6 +28,12 @@ public:
         return base().lookup(view); //
     }
 
+    // lookup the user conversion from one type into another in the scope of current context
+    // the innermost declaration wins - nullptr if none is visible
+    [[nodiscard]] auto lookupImplicitFrom(TypeView from, TypeView to) const -> instance::FunctionView {
+        return base().lookupImplicitFrom(from, to); //
+    }
+
     // executes a fully known call to a function and returns the result
     [[nodiscard]] auto runCall(Call call) const -> OptValueExpr {
         return base().runCall(std::move(call)); //
@@ -44,6 +50,13 @@ public:
     void reportDiagnostic(Diagnostic diagnostic) {
         return base().reportDiagnostic(std::move(diagnostic)); //
     }
+
+    // create the value of a literal token
+    // equal literals might share one constant
+    template<class Literal>
+    auto literalValue(TypeView type, const Literal& literal) -> Value {
+        return base().literalValue(type, literal);
+    }
 };
 
 template<class T>
@@ -76,19 +89,48 @@ struct NoDiagnositics {
     auto operator()(Diagnostic&&) {}
 };
 
-template<class Lookup, class RunCall, class IntrinsicType, class ReportDiagnostic = NoDiagnositics>
-struct ComposeContext : Context<ComposeContext<Lookup, RunCall, IntrinsicType, ReportDiagnostic>> {
+struct NoImplicitFrom {
+    auto operator()(TypeView, TypeView) const -> instance::FunctionView { return nullptr; }
+};
+
+struct UniqueLiterals {
+    template<class Literal>
+    auto operator()(TypeView type, const Literal& literal) -> Value {
+        auto value = Value{type};
+        value.set<Literal>() = literal;
+        return value;
+    }
+};
+
+template<
+    class Lookup,
+    class RunCall,
+    class IntrinsicType,
+    class ReportDiagnostic = NoDiagnositics,
+    class LiteralValue = UniqueLiterals,
+    class LookupImplicitFrom = NoImplicitFrom>
+struct ComposeContext
+    : Context<ComposeContext<Lookup, RunCall, IntrinsicType, ReportDiagnostic, LiteralValue, LookupImplicitFrom>> {
     Lookup lookup; // strings::View -> instance::ConstEntryRange
     RunCall runCall; // Call -> OptValueExpr
     IntrinsicType intrinsicType; // <Type> -> instance::TypeView
     ReportDiagnostic reportDiagnostic; // diagnostic::Diagnostic -> void
+    LiteralValue literalValue; // <Literal>(TypeView, Literal) -> Value
+    LookupImplicitFrom lookupImplicitFrom; // (TypeView, TypeView) -> instance::FunctionView
 
     ComposeContext(
-        Lookup&& lookup, RunCall&& runCall, IntrinsicType&& intrinsicType, ReportDiagnostic&& reportDiagnostic = {})
+        Lookup&& lookup,
+        RunCall&& runCall,
+        IntrinsicType&& intrinsicType,
+        ReportDiagnostic&& reportDiagnostic = {},
+        LiteralValue&& literalValue = {},
+        LookupImplicitFrom&& lookupImplicitFrom = {})
         : lookup(std::move(lookup))
         , runCall(std::move(runCall))
         , intrinsicType(std::move(intrinsicType))
-        , reportDiagnostic(std::move(reportDiagnostic)) {}
+        , reportDiagnostic(std::move(reportDiagnostic))
+        , literalValue(std::move(literalValue))
+        , lookupImplicitFrom(std::move(lookupImplicitFrom)) {}
 };
 
 // template deduction guide
@@ -97,5 +139,17 @@ ComposeContext(Lookup&&, RunCall&&, IntrinsicType &&)->ComposeContext<Lookup, Ru
 template<class Lookup, class RunCall, class IntrinsicType, class ReportDiagnostic>
 ComposeContext(Lookup&&, RunCall&&, IntrinsicType&&, ReportDiagnostic &&)
     ->ComposeContext<Lookup, RunCall, IntrinsicType, ReportDiagnostic>;
+template<class Lookup, class RunCall, class IntrinsicType, class ReportDiagnostic, class LiteralValue>
+ComposeContext(Lookup&&, RunCall&&, IntrinsicType&&, ReportDiagnostic&&, LiteralValue &&)
+    ->ComposeContext<Lookup, RunCall, IntrinsicType, ReportDiagnostic, LiteralValue>;
+template<
+    class Lookup,
+    class RunCall,
+    class IntrinsicType,
+    class ReportDiagnostic,
+    class LiteralValue,
+    class LookupImplicitFrom>
+ComposeContext(Lookup&&, RunCall&&, IntrinsicType&&, ReportDiagnostic&&, LiteralValue&&, LookupImplicitFrom &&)
+    ->ComposeContext<Lookup, RunCall, IntrinsicType, ReportDiagnostic, LiteralValue, LookupImplicitFrom>;
 
 } // namespace parser
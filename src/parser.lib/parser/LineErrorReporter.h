@@ -168,7 +168,7 @@ void reportDecodeErrorMarkers(
         {Paragraph{(viewMarkers.size() == 1) ? String{"The UTF8-decoder encountered an invalid encoding"}
                                              : String{"The UTF8-decoder encountered multiple invalid encodings"},
                    {}},
-         SourceCodeBlock{escapedLines, highlights, String{}, line}}};
+         SourceCodeBlock{escapedLines, highlights, String{}, line, tokenLines}}};
 
     auto expl = Explanation{String("Invalid UTF8 Encoding"), doc};
 
@@ -269,7 +269,8 @@ void reportNewline(
         for (auto& m : escapedMarkers) highlights.emplace_back(Marker{m, {}});
 
         auto doc = Document{{Paragraph{String{"The indentation mixes tabs and spaces."}, {}},
-                             SourceCodeBlock{escapedLines, highlights, String{}, text::Line{nli.position.line.v - 1}}}};
+                             SourceCodeBlock{
+                                 escapedLines, highlights, String{}, text::Line{nli.position.line.v - 1}, tokenLines}}};
 
         auto expl = Explanation{String("Mixed Indentation Characters"), doc};
 
@@ -315,7 +316,7 @@ void reportStringLiteral(
         switch (err.kind) {
         case Kind::EndOfInput: {
             auto doc = Document{{Paragraph{String{"The string was not terminated."}, {}},
-                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line}}};
+                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line, tokenLines}}};
             auto expl = Explanation{String("Unexpected end of input"), doc};
             auto d = Diagnostic{Code{String{"rebuild-lexer"}, 10}, Parts{expl}};
             context.reportDiagnostic(std::move(d));
@@ -327,7 +328,7 @@ void reportStringLiteral(
         }
         case Kind::InvalidEscape: {
             auto doc = Document{{Paragraph{String{"These Escape sequences are unknown."}, {}},
-                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line}}};
+                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line, tokenLines}}};
             auto expl = Explanation{String("Unkown escape sequence"), doc};
             auto d = Diagnostic{Code{String{"rebuild-lexer"}, 11}, Parts{expl}};
             context.reportDiagnostic(std::move(d));
@@ -335,7 +336,7 @@ void reportStringLiteral(
         }
         case Kind::InvalidControl: {
             auto doc = Document{{Paragraph{String{"Use of invalid control characters. Use escape sequences."}, {}},
-                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line}}};
+                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line, tokenLines}}};
             auto expl = Explanation{String("Unkown control characters"), doc};
             auto d = Diagnostic{Code{String{"rebuild-lexer"}, 12}, Parts{expl}};
             context.reportDiagnostic(std::move(d));
@@ -343,7 +344,7 @@ void reportStringLiteral(
         }
         case Kind::InvalidDecimalUnicode: {
             auto doc = Document{{Paragraph{String{"Use of invalid decimal unicode values."}, {}},
-                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line}}};
+                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line, tokenLines}}};
             auto expl = Explanation{String("Invalid decimal unicode"), doc};
             auto d = Diagnostic{Code{String{"rebuild-lexer"}, 13}, Parts{expl}};
             context.reportDiagnostic(std::move(d));
@@ -351,7 +352,7 @@ void reportStringLiteral(
         }
         case Kind::InvalidHexUnicode: {
             auto doc = Document{{Paragraph{String{"Use of invalid hexadecimal unicode values."}, {}},
-                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line}}};
+                                 SourceCodeBlock{escapedLines, highlights, String{}, sl.position.line, tokenLines}}};
             auto expl = Explanation{String("Invalid hexadecimal unicode"), doc};
             auto d = Diagnostic{Code{String{"rebuild-lexer"}, 14}, Parts{expl}};
             context.reportDiagnostic(std::move(d));
@@ -393,21 +394,24 @@ void reportNumberLiteral(
             },
             [&, &escapedLines = escapedLines](const scanner::NumberMissingExponent&) {
                 auto doc = Document{{Paragraph{String{"After the exponent sign an actual value is expected."}, {}},
-                                     SourceCodeBlock{escapedLines, highlights, String{}, nl.position.line}}};
+                                     SourceCodeBlock{
+                                         escapedLines, highlights, String{}, nl.position.line, tokenLines}}};
                 auto expl = Explanation{String("Missing exponent value"), doc};
                 auto d = Diagnostic{Code{String{"rebuild-lexer"}, 20}, Parts{expl}};
                 context.reportDiagnostic(std::move(d));
             },
             [&, &escapedLines = escapedLines](const scanner::NumberMissingValue&) {
                 auto doc = Document{{Paragraph{String{"After the radix sign an actual value is expected."}, {}},
-                                     SourceCodeBlock{escapedLines, highlights, String{}, nl.position.line}}};
+                                     SourceCodeBlock{
+                                         escapedLines, highlights, String{}, nl.position.line, tokenLines}}};
                 auto expl = Explanation{String("Missing value"), doc};
                 auto d = Diagnostic{Code{String{"rebuild-lexer"}, 21}, Parts{expl}};
                 context.reportDiagnostic(std::move(d));
             },
             [&, &escapedLines = escapedLines](const scanner::NumberMissingBoundary&) {
                 auto doc = Document{{Paragraph{String{"The number literal ends with an unknown suffix."}, {}},
-                                     SourceCodeBlock{escapedLines, highlights, String{}, nl.position.line}}};
+                                     SourceCodeBlock{
+                                         escapedLines, highlights, String{}, nl.position.line, tokenLines}}};
                 auto expl = Explanation{String("Missing boundary"), doc};
                 auto d = Diagnostic{Code{String{"rebuild-lexer"}, 22}, Parts{expl}};
                 context.reportDiagnostic(std::move(d));
@@ -445,21 +449,24 @@ void reportIdentifierLiteral(
             },
             [&, &escapedLines = escapedLines](const scanner::OperatorWrongClose&) {
                 auto doc = Document{{Paragraph{String{"The closing sign does not match the opening sign."}, {}},
-                                     SourceCodeBlock{escapedLines, highlights, String{}, ol.position.line}}};
+                                     SourceCodeBlock{
+                                         escapedLines, highlights, String{}, ol.position.line, tokenLines}}};
                 auto expl = Explanation{String("Operator wrong close"), doc};
                 auto d = Diagnostic{Code{String{"rebuild-lexer"}, 30}, Parts{expl}};
                 context.reportDiagnostic(std::move(d));
             },
             [&, &escapedLines = escapedLines](const scanner::OperatorUnexpectedClose&) {
                 auto doc = Document{{Paragraph{String{"There was no opening sign before the closing sign."}, {}},
-                                     SourceCodeBlock{escapedLines, highlights, String{}, ol.position.line}}};
+                                     SourceCodeBlock{
+                                         escapedLines, highlights, String{}, ol.position.line, tokenLines}}};
                 auto expl = Explanation{String("Operator unexpected close"), doc};
                 auto d = Diagnostic{Code{String{"rebuild-lexer"}, 31}, Parts{expl}};
                 context.reportDiagnostic(std::move(d));
             },
             [&, &escapedLines = escapedLines](const scanner::OperatorNotClosed&) {
                 auto doc = Document{{Paragraph{String{"The operator ends before the closing sign was found."}, {}},
-                                     SourceCodeBlock{escapedLines, highlights, String{}, ol.position.line}}};
+                                     SourceCodeBlock{
+                                         escapedLines, highlights, String{}, ol.position.line, tokenLines}}};
                 auto expl = Explanation{String("Operator not closed"), doc};
                 auto d = Diagnostic{Code{String{"rebuild-lexer"}, 32}, Parts{expl}};
                 context.reportDiagnostic(std::move(d));
@@ -504,7 +511,7 @@ void reportUnexpectedCharacter(
                        : String{"The tokenizer encountered multiple characters that are not part of any Rebuild "
                                 "language token."},
                    {}},
-         SourceCodeBlock{escapedLines, highlights, String{}, uc.position.line}}};
+         SourceCodeBlock{escapedLines, highlights, String{}, uc.position.line, tokenLines}}};
 
     auto expl = Explanation{String("Unexpected characters"), doc};
 
@@ -528,7 +535,7 @@ void reportUnexpectedColon(
     for (auto& m : escapedMarkers) highlights.emplace_back(Marker{m, {}});
 
     auto doc = Document{{Paragraph{String{"The colon cannot be the only token on a line."}, {}},
-                         SourceCodeBlock{escapedLines, highlights, String{}, uc.position.line}}};
+                         SourceCodeBlock{escapedLines, highlights, String{}, uc.position.line, tokenLines}}};
 
     auto expl = Explanation{String("Unexpected colon"), doc};
 
@@ -564,7 +571,7 @@ void reportUnexpectedIndent(
 
     auto doc = Document{
         {Paragraph{String{"The indentation is above the regular block level, but does not leave the block."}, {}},
-         SourceCodeBlock{escapedLines, highlights, String{}, ui.position.line}}};
+         SourceCodeBlock{escapedLines, highlights, String{}, ui.position.line, tokenLines}}};
 
     auto expl = Explanation{String("Unexpected indent"), doc};
 
@@ -594,7 +601,7 @@ void reportUnexpectedTokenAfterEnd(
     for (auto& m : escapedMarkers) highlights.emplace_back(Marker{m, {}});
 
     auto doc = Document{{Paragraph{String{"After end no more tokens are allowed."}, {}},
-                         SourceCodeBlock{escapedLines, highlights, String{}, utae.position.line}}};
+                         SourceCodeBlock{escapedLines, highlights, String{}, utae.position.line, tokenLines}}};
 
     auto expl = Explanation{String("Unexpected tokens after end"), doc};
 
@@ -626,7 +633,7 @@ void reportUnexpectedBlockEnd(
     for (auto& m : escapedMarkers) highlights.emplace_back(Marker{m, {}});
 
     auto doc = Document{{Paragraph{String{"The end keyword is only allowed to end blocks"}, {}},
-                         SourceCodeBlock{escapedLines, highlights, String{}, ube.position.line}}};
+                         SourceCodeBlock{escapedLines, highlights, String{}, ube.position.line, tokenLines}}};
 
     auto expl = Explanation{String("Unexpected block end"), doc};
 
@@ -649,7 +656,7 @@ void reportMissingBlockEnd(
     for (auto& m : escapedMarkers) highlights.emplace_back(Marker{m, {}});
 
     auto doc = Document{{Paragraph{String{"The block ended without the end keyword"}, {}},
-                         SourceCodeBlock{escapedLines, highlights, String{}, ube.position.line}}};
+                         SourceCodeBlock{escapedLines, highlights, String{}, ube.position.line, tokenLines}}};
 
     auto expl = Explanation{String("Missing Block End"), doc};
 
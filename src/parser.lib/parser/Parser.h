@@ -50,7 +50,7 @@ struct ViewNameTypeValueTuple {
 
     ViewNameTypeValueTuple() = default;
     ViewNameTypeValueTuple(const NameTypeValueTuple& ntvTuple) noexcept
-        : tuple(ntvTuple.tuple.begin(), ntvTuple.tuple.end()) {}
+        : tuple(ntvTuple.tuple->begin(), ntvTuple.tuple->end()) {}
     explicit ViewNameTypeValueTuple(const ValueExpr& node) noexcept
         : tuple({ViewNameTypeValue{node}}) {}
 };
@@ -61,15 +61,15 @@ struct Parser {
     [[nodiscard]] static auto parseBlock(const InputBlockLiteral& blockLiteral, C context) -> Block {
         static_assert(is_context<C>);
         auto block = Block{};
-        for (const auto& line : blockLiteral.value.lines) {
+        for (const auto& line : *blockLiteral.value.lines) {
             if (!blockLiteral.isTainted && line.hasErrors()) reportLineErrors(line, context);
             auto it = BlockLineView(&line);
             if (it) {
                 auto expr = parseNameTypeValueTuple(it, context);
-                if (!expr.tuple.empty()) {
-                    if (1 == expr.tuple.size() && expr.tuple.front().onlyValue()) {
+                if (!expr.tuple->empty()) {
+                    if (1 == expr.tuple->size() && expr.tuple->front().onlyValue()) {
                         // no reason to keep the tuple around, unwrap it
-                        block.expressions.emplace_back(std::move(expr).tuple.front().value.value().visit(
+                        block.expressions.emplace_back(std::move(expr.tuple.modify().front().value.value()).visit(
                             [](auto&& v) -> BlockExpr { return std::move(v); }));
                     }
                     else {
@@ -97,7 +97,7 @@ private:
         while (it) {
             auto opt = parseNameTypeValue(it, subContext);
             if (opt) {
-                tuple.tuple.push_back(std::move(opt).value());
+                tuple.tuple.modify().push_back(std::move(opt).value());
             }
             auto r = parseOptionalComma(it);
             if (r == ParseOptions::finish_single) break;
@@ -257,7 +257,7 @@ private:
             std::move(optValue).value().visit(
                 [&](auto&& val) { result = {std::move(val)}; },
                 [&](ModuleReference&& mod) {
-                    auto f = mod.module->locals.byName(parser::nameOfType());
+                    auto f = mod.module->members().byName(parser::nameOfType());
                     if (f.single() && f.frontValue().holds<instance::TypePtr>()) {
                         result = {TypeReference{f.frontValue().get<instance::TypePtr>().get()}};
                     }
@@ -316,16 +316,14 @@ private:
         if (type == nullptr) {
             assert(type); // this has to resolve a valid API type!
         }
-        auto value = Value{type};
-        value.set<ValueType>() = ValueType{token};
-        return value;
+        return context.literalValue(type, ValueType{token});
     }
 
     [[nodiscard]] static auto lookupModule(const strings::View& id, const OptValueExpr& result)
         -> instance::ConstEntryRange {
         return result.map([&](const ValueExpr& n) -> instance::ConstEntryRange {
             return n.visit(
-                [&](const ModuleReference& ref) { return ref.module->locals.byName(id); },
+                [&](const ModuleReference& ref) { return ref.module->members().byName(id); },
                 // [&](const VariableReference& ref) {},
                 // [&](const ParameterReference& ref) {},
                 // [&](const NameTypeValueReference& ref) {},
@@ -366,15 +364,14 @@ private:
         // TODO(arBmind): add overloads
     }
 
-    [[nodiscard]] static bool canImplicitConvertToType(ValueExprView node, const parser::TypeView& type) {
-        // TODO(arBmind):
-        // I guess we need a scope here
-        (void)node;
-        (void)type;
-        return true;
+    template<class Context>
+    [[nodiscard]] static bool canImplicitConvertToType(
+        ValueExprView node, const parser::TypeView& type, Context& context) {
+        return isImplicitConvertible(*node, type, context);
     }
 
-    static void assignLeftArguments(CallOverloads& co, const OptValueExpr& left) {
+    template<class Context>
+    static void assignLeftArguments(CallOverloads& co, const OptValueExpr& left, Context& context) {
         auto leftView = left //
             ? left.value().holds<NameTypeValueTuple>() //
                 ? ViewNameTypeValueTuple{left.value().get<NameTypeValueTuple>()}
@@ -393,7 +390,7 @@ private:
                     if (optParam) {
                         instance::ParameterView param = optParam.value();
                         if (param->side == instance::ParameterSide::left //
-                            && canImplicitConvertToType(ntv.value.value(), param->variable->type)) {
+                            && canImplicitConvertToType(ntv.value.value(), param->variable->type, context)) {
                             t++;
                             continue;
                         }
@@ -405,7 +402,7 @@ private:
                 else if (o < lp.size()) {
                     const auto& param = lp[o];
                     if (param->side == instance::ParameterSide::left //
-                        && canImplicitConvertToType(ntv.value.value(), param->variable->type)) {
+                        && canImplicitConvertToType(ntv.value.value(), param->variable->type, context)) {
                         o++;
                         continue;
                     }
@@ -428,6 +425,10 @@ private:
         [[nodiscard]] auto intrinsicType(meta::Type<Type>) -> instance::TypeView {
             return context->intrinsicType(meta::Type<Type>{});
         }
+        [[nodiscard]] auto lookup(strings::View view) -> instance::ConstEntryRange { return context->lookup(view); }
+        [[nodiscard]] auto lookupImplicitFrom(TypeView from, TypeView to) -> instance::FunctionView {
+            return context->lookupImplicitFrom(from, to);
+        }
         void reportDiagnostic(diagnostic::Diagnostic diagnostic) {
             return context->reportDiagnostic(std::move(diagnostic));
         }
@@ -440,6 +441,7 @@ private:
         [[nodiscard]] auto parseNtvWithCallback(BlockLineView& it, Callback&& cb) -> OptNameTypeValue {
             return Parser::parseNameTypeValueCallback(it, *context, cb);
         }
+        [[nodiscard]] auto runCall(Call call) -> OptValueExpr { return context->runCall(std::move(call)); }
         Context* context;
     };
 
@@ -452,7 +454,7 @@ private:
 
         auto co = CallOverloads{};
         co.items.emplace_back(fun.get());
-        assignLeftArguments(co, left);
+        assignLeftArguments(co, left, context);
 
         CallParser::parse(co, it, Wrap<Context>{&context});
         if (co.countComplete() == 1) {
@@ -10,7 +10,7 @@ struct LocalTupleLookup {
 
     [[nodiscard]] auto byName(View name) const& -> OptNameTypeValueView {
         if (tuple == nullptr) return {};
-        for (const auto& ntv : tuple->tuple) {
+        for (const auto& ntv : *tuple->tuple) {
             if (ntv.name && name.isContentEqual(ntv.name.value())) return &ntv;
         }
         return {};
@@ -14,6 +14,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -106,7 +107,7 @@ struct IntrinsicType {
 
 TEST_P(ExpressionParser, calls) {
     const ExpressionParserData& data = GetParam();
-    const auto input = nesting::BlockLiteral{{}, {{data.input}}};
+    const auto input = nesting::BlockLiteral{{}, {nesting::BlockLines{data.input}}};
     const auto scope = data.scope;
     const auto& expected = *data.expected;
 
@@ -121,6 +122,7 @@ TEST_P(ExpressionParser, calls) {
     auto parsed = parser::Parser::parseBlock(input, context);
 
     ASSERT_EQ(parsed, expected);
+    ASSERT_EQ(parsed.hash(), expected.hash());
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -198,3 +200,148 @@ INSTANTIATE_TEST_CASE_P(
                 .out(tuple(ntv("a").type(typeExpr(type("u64_array")))));
         }()),
     [](const ::testing::TestParamInfo<ExpressionParserData>& inf) { return inf.param.name; });
+
+// literal arguments are converted while parsing with the declared implicitFrom function
+TEST(ExpressionParser, implicitFrom) {
+    const auto scope = std::make_shared<Scope>();
+    instance::buildScope(
+        *scope,
+        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+        instance::typeModT<uint64_t>("u64"),
+        instance::fun("fromLiteral")
+            .compiletime()
+            .params(
+                instance::param("literal").right().type(type("NumLit")),
+                instance::param("result").result().type(type("u64"))),
+        instance::fun("print").runtime().params(instance::param("v").type(type("u64"))));
+    const auto* numLit = instance::lookupA<instance::TypePtr>(*scope, View{"NumLit"}).get();
+    const auto* u64 = instance::lookupA<instance::TypePtr>(*scope, View{"u64"}).get();
+    const auto& fromLiteral = instance::lookupA<instance::FunctionPtr>(*scope, View{"fromLiteral"});
+    const auto& print = instance::lookupA<instance::FunctionPtr>(*scope, View{"print"});
+    parser::declareImplicitFrom(numLit, u64, fromLiteral.get());
+
+    auto converted = Value{u64};
+    converted.set<uint64_t>() = 7;
+    auto conversions = 0;
+    auto context = ComposeContext{
+        [scope = scope.get()](strings::View id) { return scope->byName(id); },
+        [&](const parser::Call& call) -> OptValueExpr {
+            if (call.function != fromLiteral.get()) return {};
+            conversions++;
+            return ValueExpr{converted};
+        },
+        IntrinsicType{scope} //
+    };
+
+    auto line = BlockLine{
+        {nesting::buildToken(nesting::id(View{"print"})), nesting::buildToken(nesting::num("1"))}, {}};
+    const auto input = nesting::BlockLiteral{{}, {nesting::BlockLines{line}}};
+    auto parsed = parser::Parser::parseBlock(input, context);
+
+    auto expected = Block{};
+    expected.expressions.emplace_back(Call{print.get(), {ArgumentAssignment{print->parameters[0].get(), {converted}}}});
+    EXPECT_EQ(parsed, expected);
+    EXPECT_EQ(conversions, 1);
+}
+
+// a failing conversion rejects the call and reports the argument
+TEST(ExpressionParser, failedImplicitFrom) {
+    const auto scope = std::make_shared<Scope>();
+    instance::buildScope(
+        *scope,
+        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+        instance::typeModT<uint64_t>("u64"),
+        instance::fun("fromLiteral")
+            .compiletime()
+            .params(
+                instance::param("literal").right().type(type("NumLit")),
+                instance::param("result").result().type(type("u64"))),
+        instance::fun("print").runtime().params(instance::param("v").type(type("u64"))));
+    const auto* numLit = instance::lookupA<instance::TypePtr>(*scope, View{"NumLit"}).get();
+    const auto* u64 = instance::lookupA<instance::TypePtr>(*scope, View{"u64"}).get();
+    const auto& fromLiteral = instance::lookupA<instance::FunctionPtr>(*scope, View{"fromLiteral"});
+    parser::declareImplicitFrom(numLit, u64, fromLiteral.get());
+
+    auto diagnostics = diagnostic::Diagnostics{};
+    auto context = ComposeContext{
+        [scope = scope.get()](strings::View id) { return scope->byName(id); },
+        [&](const parser::Call&) -> OptValueExpr { return {}; }, // literal out of range
+        IntrinsicType{scope},
+        [&](diagnostic::Diagnostic d) { diagnostics.push_back(std::move(d)); }};
+
+    static constexpr const char source[] = "print 99999999999999999999";
+    auto literal = nesting::num("99999999999999999999");
+    literal.input = View{source + 6, source + sizeof(source) - 1};
+    auto line = BlockLine{
+        {nesting::buildToken(nesting::id(View{source, source + 5})), nesting::buildToken(std::move(literal))}, {}};
+    const auto input = nesting::BlockLiteral{{}, {nesting::BlockLines{line}}};
+    auto parsed = parser::Parser::parseBlock(input, context);
+
+    auto isCall = [](const BlockExpr& expr) { return expr.holds<Call>(); };
+    EXPECT_TRUE(std::none_of(parsed.expressions.begin(), parsed.expressions.end(), isCall));
+    ASSERT_EQ(diagnostics.size(), 1u);
+    EXPECT_EQ(diagnostics.front().code.clazzId, strings::String{"rebuild-call"});
+    EXPECT_EQ(diagnostics.front().code.number, 2u);
+}
+
+// user conversions are only visible in the scope that declares them
+TEST(ExpressionParser, implicitFromIsScoped) {
+    const auto root = std::make_shared<Scope>();
+    instance::buildScope(
+        *root,
+        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+        instance::typeModT<uint64_t>("u64"),
+        instance::fun("print").runtime().params(instance::param("v").type(type("u64"))));
+    const auto declaring = std::make_shared<Scope>(root);
+    instance::buildScope(
+        *declaring,
+        instance::fun("implicitFrom")
+            .compiletime()
+            .params(
+                instance::param("literal").right().type(type("NumLit")),
+                instance::param("result").result().type(type("u64"))));
+    const auto other = std::make_shared<Scope>(root);
+    const auto inner = std::make_shared<Scope>(declaring); // declares an unrelated conversion
+    instance::buildScope(
+        *inner,
+        instance::fun("implicitFrom")
+            .compiletime()
+            .params(
+                instance::param("value").right().type(type("u64")),
+                instance::param("result").result().type(type("NumLit"))));
+    const auto* u64 = instance::lookupA<instance::TypePtr>(*root, View{"u64"}).get();
+    const auto& print = instance::lookupA<instance::FunctionPtr>(*root, View{"print"});
+    const auto& implicitFrom = instance::lookupA<instance::FunctionPtr>(*declaring, View{"implicitFrom"});
+
+    auto converted = Value{u64};
+    converted.set<uint64_t>() = 7;
+    auto conversions = 0;
+    auto parseIn = [&](const ScopePtr& scope) {
+        auto context = ComposeContext{
+            [scope = scope.get()](strings::View id) { return scope->byName(id); },
+            [&](const parser::Call& call) -> OptValueExpr {
+                if (call.function != implicitFrom.get()) return {};
+                conversions++;
+                return ValueExpr{converted};
+            },
+            IntrinsicType{root},
+            NoDiagnositics{},
+            UniqueLiterals{},
+            [scope = scope.get()](TypeView from, TypeView to) { return scope->implicitFrom(from, to); }};
+        auto line =
+            BlockLine{{nesting::buildToken(nesting::id(View{"print"})), nesting::buildToken(nesting::num("1"))}, {}};
+        const auto input = nesting::BlockLiteral{{}, {nesting::BlockLines{line}}};
+        return parser::Parser::parseBlock(input, context);
+    };
+
+    auto expected = Block{};
+    expected.expressions.emplace_back(Call{print.get(), {ArgumentAssignment{print->parameters[0].get(), {converted}}}});
+    EXPECT_EQ(parseIn(declaring), expected);
+    EXPECT_EQ(conversions, 1);
+
+    EXPECT_EQ(parseIn(inner), expected); // conversions of outer scopes stay visible
+    EXPECT_EQ(conversions, 2);
+
+    EXPECT_NE(parseIn(other), expected);
+    EXPECT_EQ(conversions, 2);
+}
@@ -63,7 +63,7 @@ inline auto hasSideEffects(const Call& call) -> bool {
     return hasSideEffects(call.arguments);
 }
 
-inline auto hasSideEffects(const NameTypeValueTuple& ntvt) -> bool { return any(ntvt.tuple, has_side_effects_call); }
+inline auto hasSideEffects(const NameTypeValueTuple& ntvt) -> bool { return any(*ntvt.tuple, has_side_effects_call); }
 
 inline auto hasSideEffects(const NameTypeValue& ntv) -> bool { return ntv.value.map(has_side_effects_call); }
 
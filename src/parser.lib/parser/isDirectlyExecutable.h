@@ -26,7 +26,7 @@ inline bool isDirectlyExecutable(const ValueExpr& node) {
         [](const VariableInit&) { return false; },
         [](const ModuleReference& mr) { return mr.module != nullptr; },
         [](const NameTypeValueTuple& tuple) {
-            for (auto& indexNtvs : tuple.tuple)
+            for (auto& indexNtvs : *tuple.tuple)
                 if (!isDirectlyExecutable(indexNtvs)) return false;
             return true;
         },
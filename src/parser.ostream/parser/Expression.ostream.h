@@ -94,9 +94,9 @@ inline auto operator<<(std::ostream& out, const NameTypeValue& t) -> std::ostrea
     return out;
 }
 inline auto operator<<(std::ostream& out, const NameTypeValueTuple& nt) -> std::ostream& {
-    size_t size = nt.tuple.size();
+    size_t size = nt.tuple->size();
     if (size > 1) out << "(";
-    strings::join(out, nt.tuple, ", ");
+    strings::join(out, *nt.tuple, ", ");
     if (size > 1) out << ")";
     return out;
 }
@@ -1,27 +1,36 @@
 #include "rec/Compiler.h"
+#include "rec/Workers.h"
 
+#include "cache/CallCache.ostream.h"
+#include "instrumentation/Profile.ostream.h"
+#include "meta/EventCounter.ostream.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #    include <Windows.h>
 #endif
 
-int main() {
-
-#ifdef _WIN32
-    SetConsoleOutputCP(CP_UTF8);
-#endif
-
-    using namespace rec;
-
-    auto config = Config{text::Column{8}};
-    // config.tokenOutput = &std::cout;
-    // config.blockOutput = &std::cout;
-    config.diagnosticsOutput = &std::cout;
+namespace {
 
-    auto compiler = Compiler{config};
+auto readFile(const char* path) -> std::optional<text::File> {
+    auto in = std::ifstream{path, std::ios::binary};
+    if (!in) return {};
+    auto content = std::vector<char>{std::istreambuf_iterator<char>{in}, {}};
+    auto name = std::string_view{path};
+    return text::File{strings::String{name.data(), name.data() + name.size()}, strings::String{std::move(content)}};
+}
 
-    auto file = text::File{
+auto demoFile() -> text::File {
+    return text::File{
         strings::String{"TestFile"},
         strings::String{""
                         R"(# Rebuild.Context.declareVariable hif :Rebuild.literal.String = "Hello from Global!"
@@ -41,6 +50,96 @@ Rebuild.Context.declareModule test:
     Rebuild.say "Hello from parsing module test!"
 end
 )"}};
+}
+
+// size and modification time of the running executable - a rebuilt compiler does not reuse cached results
+auto buildId(const char* argv0) -> cache::Bytes {
+    namespace fs = std::filesystem;
+    auto ec = std::error_code{};
+    auto path = fs::path{"/proc/self/exe"};
+    if (!fs::exists(path, ec)) path = argv0;
+    auto size = static_cast<uint64_t>(fs::file_size(path, ec));
+    auto time = static_cast<uint64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    auto id = cache::Bytes{};
+    for (auto value : {size, time})
+        for (auto i = 0u; i < 8u; i++) id.push_back(static_cast<uint8_t>(value >> (8u * i)));
+    return id;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+
+    using namespace rec;
+
+    auto config = Config{text::Column{8}};
+    // config.tokenOutput = &std::cout;
+    // config.blockOutput = &std::cout;
+    config.diagnosticsOutput = &std::cout;
+
+    auto profile = instrumentation::Profile{};
+    auto eventCounts = meta::EventCounts{};
+    auto callCache = std::optional<cache::CallCache>{};
+    auto rebuildOutput = std::optional<std::ofstream>{};
+    auto preludePath = static_cast<const char*>(nullptr);
+    auto inputPaths = std::vector<const char*>{};
+    auto jobs = size_t{1};
+    for (auto i = 1; i < argc; i++) {
+        auto arg = std::string_view{argv[i]};
+        if (arg.substr(0, 1) != "-") inputPaths.push_back(argv[i]);
+        if (arg == "--prelude" && i + 1 < argc) preludePath = argv[++i];
+        if (arg == "-j" && i + 1 < argc) jobs = std::strtoul(argv[++i], nullptr, 10);
+        if (arg == "--perf-counters") config.profile = &profile;
+        if (arg == "--event-counts") config.eventCounts = &eventCounts;
+        if (arg == "--memory-report") config.memoryReportOutput = &std::cout;
+        if (arg == "--lazy-modules") config.lazyModules = true;
+        if (arg == "--parallel-calls") config.callThreads = std::thread::hardware_concurrency();
+        if (arg == "--quiet") config.rebuildOutput = nullptr;
+        if (arg == "--output" && i + 1 < argc) config.rebuildOutput = &rebuildOutput.emplace(argv[++i]);
+        if (arg == "--call-cache" && i + 1 < argc) {
+            constexpr auto maxCacheBytes = uint64_t{64} << 20u;
+            config.callCache = &callCache.emplace(argv[++i], maxCacheBytes, buildId(argv[0]));
+        }
+    }
+
+    if (jobs > 1 && config.callThreads > 1) {
+        std::cerr << "rec: -j cannot be combined with --parallel-calls\n"; // forked workers would miss the threads
+        return 1;
+    }
+
+    auto compiler = Compiler{config};
+
+    if (preludePath) {
+        auto prelude = readFile(preludePath);
+        if (!prelude) {
+            std::cerr << "rec: cannot read " << preludePath << '\n';
+            return 1;
+        }
+        compiler.compile(prelude.value());
+    }
+    if (!inputPaths.empty()) {
+        auto files = TextFiles{};
+        for (const auto* path : inputPaths) {
+            auto file = readFile(path);
+            if (!file) {
+                std::cerr << "rec: cannot read " << path << '\n';
+                return 1;
+            }
+            files.push_back(std::move(file).value());
+        }
+        // every input file starts from the same prelude - workers share it through copy-on-write pages
+        auto snapshot = compiler.snapshot();
+        for (const auto& result : compileFiles(config, snapshot, files, jobs).results) std::cout << result;
+    }
+    else {
+        compiler.compile(demoFile()); // no input files - compile a small showcase
+    }
 
-    compiler.compile(file);
+    if (config.profile) std::cout << '\n' << profile;
+    if (config.eventCounts) std::cout << '\n' << eventCounts;
+    if (config.callCache) std::cout << '\n' << config.callCache->stats();
 }
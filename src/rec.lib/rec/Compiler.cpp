@@ -4,7 +4,7 @@
 #include "nesting/nestTokens.h"
 #include "parser/Parser.h"
 #include "scanner/tokenize.h"
-#include "strings/utf8Decode.h"
+#include "serialize/Format.h"
 
 #include "api/Context.h"
 #include "intrinsic/Adapter.h"
@@ -15,7 +15,11 @@
 #include "parser/Expression.ostream.h"
 #include "scanner/Token.ostream.h"
 
+#include "meta/Overloaded.h"
+
 #include <iostream>
+#include <iterator>
+#include <utility>
 
 namespace rec {
 
@@ -63,12 +67,114 @@ auto extractResults(Call& call, const InstanceScopePtr& globals) -> OptValueExpr
     return getResultValue(call).map([&](parser::Value&& result) -> OptValueExpr {
         auto resultType = result.type();
         if (resultType == IntrinsicType{globals.get()}(meta::type<parser::NameTypeValue>)) {
-            return parser::ValueExpr(parser::NameTypeValueTuple{{std::move(result).get<parser::NameTypeValue>()}});
+            auto tuple = parser::NameTypeValueTuple{};
+            tuple.tuple.modify().push_back(std::move(result).get<parser::NameTypeValue>());
+            return parser::ValueExpr(std::move(tuple));
         }
         return parser::ValueExpr{std::move(result)};
     });
 }
 
+auto textOf(const serialize::Bytes& bytes) -> strings::String {
+    const auto* begin = reinterpret_cast<const char*>(bytes.data());
+    return strings::String{begin, begin + bytes.size()};
+}
+
+/// calls the visitor for the scope and every function, module and scope declared inside of it
+template<class Visitor>
+void walkScope(instance::LocalScope& scope, Visitor&& visitor) {
+    visitor(scope);
+    for (auto& entry : scope) {
+        entry.visitSome(
+            [&](const instance::FunctionPtr& function) {
+                visitor(*function);
+                walkScope(function->parameterScope, visitor);
+                function->body.visitSome([&](instance::ParsedBlock& parsed) { walkScope(parsed.locals, visitor); });
+            },
+            [&](const instance::ModulePtr& module) {
+                visitor(*module);
+                walkScope(module->locals, visitor);
+            });
+    }
+}
+
+// pending bodies keep their parent scopes and this compiler alive
+// the visitor runs before the module members are walked, so nested modules are parsed as well
+void parsePendingBodies(instance::LocalScope& scope) {
+    walkScope(
+        scope,
+        meta::Overloaded{
+            [](instance::LocalScope&) {},
+            [](instance::Function&) {},
+            [](instance::Module& module) { (void)module.members(); },
+        });
+}
+
+void dropPendingBodies(instance::LocalScope& scope) {
+    walkScope(
+        scope,
+        meta::Overloaded{
+            [](instance::LocalScope&) {},
+            [](instance::Function&) {},
+            [](instance::Module& module) { module.dropPendingBody(); },
+        });
+}
+
+/// replaces every copy of a pooled literal in the parsed nodes with its relocated value
+// compile time results hold parser nodes in their payloads - they are walked as well
+struct RebaseValues {
+    const ConstantPool::Relocation& relocation;
+    parser::TypeView variableInitType{};
+    parser::TypeView tupleType{};
+
+    void operator()(parser::Value& value) const {
+        relocation.rebase(value);
+        if (value.type() == nullptr) return;
+        if (value.type() == variableInitType) (*this)(value.set<parser::VariableInit>());
+        if (value.type() == tupleType) (*this)(value.set<parser::NameTypeValueTuple>());
+    }
+    void operator()(parser::Call& call) const {
+        for (auto& assign : call.arguments) each(assign.values);
+    }
+    void operator()(parser::Block& block) const { each(block.expressions); }
+    void operator()(parser::VecOfPartiallyParsed& nodes) const { each(nodes); }
+    void operator()(parser::ModuleInit& init) const { each(init.nodes); }
+    void operator()(parser::VariableInit& init) const { each(init.nodes); }
+    // entries are referenced by address - a shared tuple would be copied by modify()
+    void operator()(parser::NameTypeValueTuple& tuple) const {
+        if (tuple.tuple.isShared()) return;
+        for (auto& entry : tuple.tuple.modify()) {
+            if (entry.type) (*this)(entry.type.value());
+            if (entry.value) (*this)(entry.value.value());
+        }
+    }
+    template<class Variant>
+    requires requires(Variant& v) { v.visit([](auto&) {}); }
+    void operator()(Variant& variant) const {
+        variant.visit([this](auto& node) { (*this)(node); });
+    }
+    template<class Node>
+    void operator()(Node&) const {} // references and literals hold no values
+
+    template<class Nodes>
+    void each(Nodes& nodes) const {
+        for (auto& node : nodes) (*this)(node);
+    }
+};
+
+// copying a body allocates all of its nodes in one pass with exact capacities
+void relocateFunction(instance::Function& function, const RebaseValues& rebase) {
+    for (auto& parameter : function.parameters) {
+        rebase(parameter->type);
+        rebase.each(parameter->defaultValue);
+    }
+    function.body.visitSome([&](instance::ParsedBlock& parsed) {
+        auto relocated = parsed.block;
+        parsed.block = std::move(relocated);
+        rebase(parsed.block);
+    });
+}
+
 } // namespace
 
 auto Compiler::executionContext(const InstanceScopePtr& parserScope) {
@@ -84,50 +190,146 @@ auto Compiler::executionContext(const InstanceScopePtr& parserScope) {
     return r;
 }
 
+// symbols are collected once per compile - calls of functions declared later in the compile are not cached
+auto Compiler::callKey(const Call& call) -> meta::Optional<serialize::Bytes> {
+    if (!symbols) symbols = std::make_unique<serialize::Symbols>(*globals);
+    if (symbols->pathOf(call.function) == nullptr) return {};
+    return serialize::saveCall(call, *symbols);
+}
+
+// calls that cannot be serialized are run as usual
+template<class Run>
+auto Compiler::runCached(const Call& call, Run&& run) -> OptValueExpr {
+    auto lock = std::unique_lock{callCacheMutex};
+    auto key = callKey(call);
+    if (key) {
+        auto& byKey = loadedCalls->byKey;
+        if (auto it = byKey.find(key.value()); it != byKey.end()) return it->second.value;
+        if (const auto* bytes = config.callCache->load(key.value()); bytes) {
+            auto loaded = LoadedCalls::Loaded{textOf(*bytes)};
+            if (auto result = serialize::loadValueExpr(StringView{loaded.bytes}, *globals); result) {
+                loaded.value = std::move(result).value();
+                return byKey.emplace(key.value(), std::move(loaded)).first->second.value;
+            }
+        }
+    }
+    lock.unlock();
+    auto result = run();
+    if (key) {
+        lock.lock();
+        auto bytes = serialize::saveValueExpr(result, *symbols);
+        if (bytes) config.callCache->store(key.value(), bytes.value());
+    }
+    return result;
+}
+
 auto Compiler::parserContext(const InstanceScopePtr& scope) {
     auto lookup = [=](const StringView& id) { return scope->byName(id); };
     auto runCall = [=](const Call& call) -> OptValueExpr {
         // TODO(arBmind):
         // * check arguments - have to be available
-        auto callCopy = call;
-        assignResultStorage(callCopy);
+        auto run = [&] {
+            auto callCopy = call;
+            assignResultStorage(callCopy);
 
-        execution::Machine::runCall(callCopy, executionContext(scope));
+            execution::Machine::runCall(callCopy, executionContext(scope));
 
-        return extractResults(callCopy, globals);
+            return extractResults(callCopy, globals);
+        };
+        if (config.callCache && execution::Machine::isPure(call)) return runCached(call, run);
+        return run();
     };
-    auto reportDiagnostic = [this](Diagnostic diagnostic) {
-        // TODO(arBmind): somehow add fileName
-        diagnostics.emplace_back(std::move(diagnostic));
+    auto reportDiagnostic = [this](Diagnostic diagnostic) { this->reportDiagnostic(std::move(diagnostic)); };
+    auto literalValue = [this](parser::TypeView type, const auto& literal) {
+        auto lock = std::unique_lock{constantsMutex};
+        return constants->intern(type, literal);
     };
+    auto lookupImplicitFrom = [=](parser::TypeView from, parser::TypeView to) { return scope->implicitFrom(from, to); };
     return parser::ComposeContext{
-        std::move(lookup), std::move(runCall), IntrinsicType{globals.get()}, std::move(reportDiagnostic)};
+        std::move(lookup),
+        std::move(runCall),
+        IntrinsicType{globals.get()},
+        std::move(reportDiagnostic),
+        std::move(literalValue),
+        std::move(lookupImplicitFrom)};
 }
 
 Compiler::Compiler(Config config, InstanceScopePtr _globals)
     : config(config)
+    , taskPool(config.callThreads > 1 ? std::make_unique<TaskPool>(config.callThreads) : nullptr)
     , globals(_globals ? std::move(_globals) : std::make_shared<InstanceScope>())
-    , globalScope(globals) {
+    , globalScope(globals)
+    , constants(std::make_shared<ConstantPool>())
+    , sources(config)
+    , loadedCalls(std::make_shared<LoadedCalls>()) {
 
-    globals->emplace(intrinsicAdapter::Adapter::moduleOf(meta::type<intrinsic::Rebuild>));
+    // forks and prepared globals already reach the intrinsics - a second copy would make them ambiguous
+    if (globals->byName(intrinsic::Rebuild::info().name).empty())
+        globals->emplace(intrinsicAdapter::Adapter::moduleOf(meta::type<intrinsic::Rebuild>));
 
     compilerCallback.parseBlock = [this](const BlockLiteral& block, const InstanceScopePtr& scope) -> parser::Block {
         return parser::Parser::parseBlock(block, parserContext(scope));
     };
-    compilerCallback.reportDiagnostic = [this](Diagnostic diagnostic) {
-        diagnostics.emplace_back(std::move(diagnostic));
+    compilerCallback.reportDiagnostic = [this](Diagnostic diagnostic) { reportDiagnostic(std::move(diagnostic)); };
+    compilerCallback.taskPool = taskPool.get();
+    compilerCallback.lazyModules = config.lazyModules;
+    if (config.rebuildOutput) compilerCallback.output = &output.emplace(config.rebuildOutput);
+}
+
+Compiler::Compiler(Config config, const Snapshot& snapshot)
+    : Compiler(std::move(config), std::make_shared<InstanceScope>(snapshot.globals)) {
+    sharedConstants = snapshot.constants;
+    sources = snapshot.sources;
+    sharedLoadedCalls = snapshot.loadedCalls;
+}
+
+Compiler::~Compiler() {
+    dropPendingBodies(*globals->locals);
+    if (globalScope != globals) dropPendingBodies(*globalScope->locals);
+}
+
+// the file is resolved from the source view - bodies of lazy modules are parsed while later files are compiled
+void Compiler::reportDiagnostic(Diagnostic diagnostic) {
+    auto lock = std::unique_lock{sourcesMutex};
+    auto setFileName = [](auto& withFile, const TextFile* file) {
+        if (withFile.fileName.isEmpty() && file) withFile.fileName = file->filename;
+    };
+    auto fileOf = [&](const diagnostic::SourceCodeBlock& block) {
+        const auto* file = sources.fileOf(sources.locOf(block.source));
+        return file ? file : currentFile;
     };
+    for (auto& part : diagnostic.parts) {
+        part.visit(
+            [&](diagnostic::Explanation& explanation) {
+                for (auto& section : explanation.details)
+                    section.visitSome([&](diagnostic::SourceCodeBlock& block) { setFileName(block, fileOf(block)); });
+            },
+            [&](diagnostic::Suggestion& suggestion) {
+                for (auto& substitution : suggestion.substitutions)
+                    for (auto& diffSection : substitution.diffSections) setFileName(diffSection, currentFile);
+            });
+    }
+    lock.unlock();
+    reported.push(std::move(diagnostic));
+}
+
+void Compiler::mergeDiagnostics() {
+    auto phaseDiagnostics = reported.take();
+    std::move(phaseDiagnostics.begin(), phaseDiagnostics.end(), std::back_inserter(diagnostics));
 }
 
-void Compiler::compile(const TextFile& file) {
-    auto decode = [&](const auto& file) { return strings::utf8Decode(file.content); };
-    auto positions = [&](const auto& file) { return text::decodePosition(decode(file), config); };
+void Compiler::compile(const TextFile& input) {
+    auto eventsBefore = config.eventCounts ? meta::readEventCounts() : EventCounts{};
+    symbols.reset();
+    auto sourcesLock = std::unique_lock{sourcesMutex};
+    const auto& file = sources.add(input);
+    currentFile = &file;
+    sourcesLock.unlock();
+    auto positions = [&](const auto& file) { return text::decodePosition(strings::View{file.content}, config); };
     auto tokenize = [&](const auto& file) { return scanner::tokenize(positions(file)); };
     auto filter = [&](const auto& file) { return filter::filterTokens(tokenize(file)); };
     auto blockify = [&](const auto& file) { return nesting::nestTokens(filter(file)); };
-    auto parse = [&](const auto& file) {
-        return parser::Parser::parseBlock(blockify(file), parserContext(globalScope));
-    };
+    auto phase = [&](const char* name, auto&& f) { return instrumentation::measure(config.profile, name, f); };
 
     if (config.tokenOutput) {
         auto& out = *config.tokenOutput;
@@ -139,7 +341,11 @@ void Compiler::compile(const TextFile& file) {
         out << "\nBlocks:\n" << blockify(file);
     }
 
-    auto block = parse(file);
+    // note: lexer stages are interleaved coroutines, we can only measure them together
+    auto blockLiteral = phase("lex", [&] { return blockify(file); });
+    auto block = phase("parse", [&] { return parser::Parser::parseBlock(blockLiteral, parserContext(globalScope)); });
+    if (output) output->flush(); // keep output of the parser before the diagnostics
+    mergeDiagnostics();
     if (!diagnostics.empty()) {
         if (config.diagnosticsOutput) {
             auto& out = *config.diagnosticsOutput;
@@ -148,7 +354,55 @@ void Compiler::compile(const TextFile& file) {
         }
     }
     else
-        execution::Machine::runBlock(block, executionContext(globals));
+        phase("execute", [&] { execution::Machine::runBlock(block, executionContext(globals)); });
+    if (output) output->flush();
+    mergeDiagnostics();
+    if (config.eventCounts) *config.eventCounts += meta::readEventCounts() - eventsBefore;
+
+    if (config.memoryReportOutput) {
+        auto report = MemoryReport{};
+        report.add(blockLiteral);
+        report.add(block);
+        report.add(*globals);
+        *config.memoryReportOutput << "\nMemory:\n" << report;
+    }
+}
+
+auto Compiler::snapshot() -> Snapshot {
+    parsePendingBodies(*globals->locals);
+    mergeDiagnostics();
+    auto shared = instance::ConstScopePtr{globals};
+    globals = std::make_shared<InstanceScope>(shared);
+    globalScope = globals;
+    symbols.reset();
+    sharedConstants.push_back(std::exchange(constants, std::make_shared<ConstantPool>()));
+    auto callsLock = std::unique_lock{callCacheMutex};
+    sharedLoadedCalls.push_back(std::exchange(loadedCalls, std::make_shared<LoadedCalls>()));
+    callsLock.unlock();
+    return Snapshot{std::move(shared), sources, sharedConstants, sharedLoadedCalls};
+}
+
+void Compiler::freeze() {
+    auto lock = std::unique_lock{constantsMutex};
+    const auto relocation = constants->freeze();
+    auto intrinsicType = IntrinsicType{globals.get()};
+    auto rebase = RebaseValues{
+        relocation,
+        intrinsicType(meta::type<parser::VariableInit>),
+        intrinsicType(meta::type<parser::NameTypeValueTuple>)};
+    walkScope(
+        *globals->locals,
+        meta::Overloaded{
+            [](instance::LocalScope&) {},
+            [&](instance::Function& function) { relocateFunction(function, rebase); },
+            [](instance::Module&) {},
+        });
+}
+
+auto Compiler::memoryReport() const -> MemoryReport {
+    auto report = MemoryReport{};
+    report.add(*globals);
+    return report;
 }
 
 } // namespace rec
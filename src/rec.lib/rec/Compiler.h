@@ -1,42 +1,114 @@
 #pragma once
+#include "MemoryReport.h"
+
+#include "cache/CallCache.h"
 #include "diagnostic/Diagnostic.h"
+#include "diagnostic/DiagnosticQueue.h"
 #include "execution/Machine.h"
+#include "instrumentation/Profile.h"
 #include "instance/Scope.h"
+#include "meta/EventCounter.h"
+#include "parser/ConstantPool.h"
+#include "serialize/Symbols.h"
 #include "text/File.h"
+#include "text/SourceManager.h"
 #include "text/decodePosition.h"
 
-#include <ostream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace rec {
 
 using TextFile = text::File;
 using TextConfig = text::Config;
+using SourceManager = text::SourceManager;
 using InstanceScope = instance::Scope;
 using InstanceScopePtr = instance::ScopePtr;
 using CompilerCallback = execution::Compiler;
+using TaskPool = execution::TaskPool;
+using ConstantPool = parser::ConstantPool;
+using CallCache = cache::CallCache;
+using OutputBuffer = execution::OutputBuffer;
+using Profile = instrumentation::Profile;
+using EventCounts = meta::EventCounts;
+using diagnostic::Diagnostic;
+using diagnostic::DiagnosticQueue;
 using diagnostic::Diagnostics;
 
 struct Config : TextConfig {
     std::ostream* tokenOutput{};
     std::ostream* blockOutput{};
     std::ostream* diagnosticsOutput{};
-    // std::ostream* rebuildOutput{}; // TODO(arBmind): allow to configure stdout used by builtin stdout
+    std::ostream* memoryReportOutput{};
+    Profile* profile{}; ///< opt-in: records wall time and hardware counters per phase
+    EventCounts* eventCounts{}; ///< opt-in: sums the hot path events of each compile (all threads of the process)
+    size_t callThreads{}; ///< opt-in: > 1 runs independent compile time calls concurrently
+    CallCache* callCache{}; ///< opt-in: reuses results of pure compile time calls - has to outlive the compiler
+    bool lazyModules{}; ///< opt-in: module bodies are parsed on the first member lookup
+    std::ostream* rebuildOutput = &std::cout; ///< compile time output (Rebuild.say) - nullptr discards it
+};
+
+using SharedConstants = std::vector<std::shared_ptr<const ConstantPool>>;
+
+/// results of one compiler loaded from the call cache - each key is loaded once
+// loaded values point into their bytes, the map keeps both at stable addresses
+struct LoadedCalls {
+    struct Loaded {
+        strings::String bytes{};
+        parser::OptValueExpr value{};
+    };
+    std::map<serialize::Bytes, Loaded> byKey{};
+};
+using SharedLoadedCalls = std::vector<std::shared_ptr<const LoadedCalls>>;
+
+/// declarations of all files compiled before rec::Compiler::snapshot()
+// never changes - compilers forked from it declare into their own scope on top of it
+// owns everything the declarations point into, so it outlives the compiler that took it
+struct Snapshot {
+    instance::ConstScopePtr globals{};
+    SourceManager sources{}; ///< files of the declarations - copies share them
+    SharedConstants constants{}; ///< pooled literals of the declarations
+    SharedLoadedCalls loadedCalls{}; ///< cached call results the declarations may point into
 };
 
 struct Compiler final {
 private:
     Config config;
+    std::unique_ptr<TaskPool> taskPool;
+    std::optional<OutputBuffer> output; // flushed after each compile
     InstanceScopePtr globals;
     InstanceScopePtr globalScope;
     CompilerCallback compilerCallback;
+    DiagnosticQueue reported; // any thread reports here, merged into diagnostics after each phase
     Diagnostics diagnostics;
+    std::shared_ptr<ConstantPool> constants;
+    std::mutex constantsMutex; // concurrent calls may parse blocks
+    SharedConstants sharedConstants; // pools of the snapshots - kept alive for the declarations
+    SourceManager sources;
+    std::mutex sourcesMutex; // tasks resolve diagnostics while files are added
+    const TextFile* currentFile{};
+    std::unique_ptr<serialize::Symbols> symbols; // paths of the cache keys - collected once per compile
+    std::mutex callCacheMutex;
+    std::shared_ptr<LoadedCalls> loadedCalls; // guarded by callCacheMutex
+    SharedLoadedCalls sharedLoadedCalls; // loaded by the snapshots - kept alive for the declarations
 
+    void reportDiagnostic(Diagnostic diagnostic);
+    void mergeDiagnostics();
+    auto callKey(const parser::Call& call) -> meta::Optional<serialize::Bytes>;
+    template<class Run>
+    auto runCached(const parser::Call& call, Run&& run) -> parser::OptValueExpr;
     auto executionContext(const InstanceScopePtr& parserScope);
     auto parserContext(const InstanceScopePtr& scope);
 
 public:
     Compiler(Config config, InstanceScopePtr globals = {});
-    ~Compiler() = default;
+    /// fork - starts with all declarations of the snapshot without compiling them again (O(1))
+    Compiler(Config config, const Snapshot& snapshot);
+    ~Compiler();
 
     // the compiler captures this in lambdas, therefore no copy or move allowed
     Compiler(const Compiler&) = delete;
@@ -44,8 +116,25 @@ public:
     Compiler& operator=(const Compiler&) = delete;
     Compiler& operator=(Compiler&&) = delete;
 
-    // run the compiler
-    void compile(const TextFile& file);
+    // run the compiler - the file is copied into the source manager
+    void compile(const TextFile& input);
+
+    /// shares all declarations so far with forked compilers
+    // pending module bodies are parsed first, so the snapshot does not depend on this compiler
+    // this compiler continues like a fork, later declarations are not part of the snapshot
+    [[nodiscard]] auto snapshot() -> Snapshot;
+
+    /// moves the pooled literals into one contiguous arena and reallocates the parsed bodies tightly
+    // copies of the literals in parameters and bodies are rebased, so the scattered payloads are released
+    // instances keep their addresses - parsed nodes and other compilers refer to them
+    // declarations of snapshots are shared and stay as they are - call between compiles
+    void freeze();
+
+    /// footprint of all declared instances and their parsed bodies
+    [[nodiscard]] auto memoryReport() const -> MemoryReport;
+
+    [[nodiscard]] auto sourceManager() const -> const SourceManager& { return sources; }
+    [[nodiscard]] auto constantPool() const -> const ConstantPool& { return *constants; }
 };
 
 } // namespace rec
@@ -0,0 +1,70 @@
+#include "Compiler.h"
+
+#include "cache/CallCache.h"
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <sstream>
+
+using namespace rec;
+
+namespace {
+
+struct TemporaryDirectory {
+    cache::Path path;
+
+    explicit TemporaryDirectory(const char* name)
+        : path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(path);
+    }
+    ~TemporaryDirectory() { std::filesystem::remove_all(path); }
+};
+
+auto compileWith(cache::CallCache& callCache) -> std::string {
+    auto diagnosticsOut = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &diagnosticsOut;
+    config.callCache = &callCache;
+    auto compiler = Compiler{config};
+    compiler.compile(text::File{strings::String{"TestFile"}, strings::String{"Rebuild.basic.u64.implicitFrom 7\n"}});
+    return diagnosticsOut.str();
+}
+
+} // namespace
+
+// a second compiler loads the result the first one stored
+TEST(CompilerCache, reusesResults) {
+    auto dir = TemporaryDirectory{"rec_compilerCache_reuses"};
+    {
+        auto callCache = cache::CallCache{dir.path, 1024 * 1024};
+        EXPECT_EQ(compileWith(callCache), "");
+        EXPECT_EQ(callCache.stats().misses, 1u);
+        EXPECT_EQ(callCache.stats().stores, 1u);
+    }
+    auto callCache = cache::CallCache{dir.path, 1024 * 1024};
+    EXPECT_EQ(compileWith(callCache), "");
+    EXPECT_EQ(callCache.stats().hits, 1u);
+    EXPECT_EQ(callCache.stats().stores, 0u);
+
+    auto otherBuild = cache::CallCache{dir.path, 1024 * 1024, cache::Bytes{1}};
+    EXPECT_EQ(compileWith(otherBuild), "");
+    EXPECT_EQ(otherBuild.stats().hits, 0u);
+}
+
+// repeated hits reuse the loaded value - the source manager only holds the compiled files
+TEST(CompilerCache, loadsEachKeyOnce) {
+    auto dir = TemporaryDirectory{"rec_compilerCache_loadsOnce"};
+    auto callCache = cache::CallCache{dir.path, 1024 * 1024};
+    EXPECT_EQ(compileWith(callCache), "");
+
+    auto config = Config{text::Column{8}};
+    config.callCache = &callCache;
+    auto compiler = Compiler{config};
+    const auto source = strings::String{"Rebuild.basic.u64.implicitFrom 7\nRebuild.basic.u64.implicitFrom 7\n"};
+    compiler.compile(text::File{strings::String{"First"}, source});
+    compiler.compile(text::File{strings::String{"Second"}, source});
+
+    EXPECT_EQ(callCache.stats().hits, 1u);
+    EXPECT_EQ(compiler.sourceManager().fileCount(), 2u);
+}
@@ -0,0 +1,39 @@
+#include "Compiler.h"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+using namespace rec;
+
+namespace {
+
+auto sayLines(int count) -> strings::String {
+    auto source = std::string{};
+    for (auto i = 0; i < count; i++) source += "Rebuild.say \"line\"\n";
+    return strings::String{source.data(), source.data() + source.size()};
+}
+
+} // namespace
+
+TEST(EventCounts, linearLookups) {
+    auto diagnosticsOut = std::stringstream{};
+    auto counts = EventCounts{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &diagnosticsOut;
+    config.rebuildOutput = nullptr;
+    config.eventCounts = &counts;
+    auto compiler = Compiler{config};
+
+    compiler.compile(text::File{strings::String{"Small"}, sayLines(10)});
+    auto small = counts;
+    counts = {};
+    compiler.compile(text::File{strings::String{"Large"}, sayLines(100)});
+    EXPECT_EQ(diagnosticsOut.str(), "");
+
+    // every line costs the same - nothing grows with the number of lines
+    EXPECT_EQ(counts[instance::scopeLookups], 10 * small[instance::scopeLookups]);
+    EXPECT_EQ(counts[instance::scopeLookupSteps], 10 * small[instance::scopeLookupSteps]);
+    EXPECT_EQ(counts[execution::runCalls], 100u);
+    EXPECT_LE(counts[instance::scopeLookups], 100u * 4);
+}
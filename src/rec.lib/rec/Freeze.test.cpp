@@ -0,0 +1,72 @@
+#include "Compiler.h"
+
+#include "api/Context.h"
+#include "intrinsic/ResolveType.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+using namespace rec;
+
+namespace {
+
+auto file(const char* name, const char* content) -> text::File {
+    return text::File{strings::String{name, name + std::strlen(name)},
+                      strings::String{content, content + std::strlen(content)}};
+}
+
+// variables declared in a body are initialized by the payloads of compile time results
+auto initValues(const parser::Block& block, const instance::Scope& globals) -> std::vector<const parser::Value*> {
+    using VariableInit = intrinsic::ResolveType<parser::VariableInit>;
+    const auto initType = VariableInit::moduleInstance<intrinsic::Rebuild>(&globals);
+    auto values = std::vector<const parser::Value*>{};
+    for (const auto& expr : block.expressions) {
+        expr.visitSome([&](const parser::Value& result) {
+            if (result.type() != initType) return;
+            for (const auto& node : result.get<parser::VariableInit>().nodes)
+                node.visitSome([&](const parser::Value& value) { values.push_back(&value); });
+        });
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(Freeze, relocatesLiterals) {
+    auto out = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &out;
+    config.rebuildOutput = &out;
+    auto globals = std::make_shared<instance::Scope>();
+    auto compiler = Compiler{config, globals};
+    compiler.compile(file(
+        "TestFile",
+        "Rebuild.Context.declareFunction left=() greet () ():\n"
+        "    Rebuild.Context.declareVariable a :Rebuild.literal.String = \"Hello\"\n"
+        "    Rebuild.Context.declareVariable b :Rebuild.literal.String = \"World\"\n"
+        "end\n"));
+
+    const auto& function = globals->locals->byName(strings::View{"greet"}).frontValue().get<instance::FunctionPtr>();
+    const auto& body = function->body.get<instance::ParsedBlock>().block;
+    auto before = initValues(body, *globals);
+    ASSERT_EQ(before.size(), 2u);
+    const auto hello = *before[0]; // keeps the old payload
+
+    compiler.freeze();
+
+    const auto* arena = compiler.constantPool().arena();
+    ASSERT_NE(arena, nullptr);
+    auto after = initValues(body, *globals);
+    ASSERT_EQ(after.size(), 2u);
+    EXPECT_NE(after[0]->data(), hello.data());
+    EXPECT_EQ(*after[0], hello);
+    EXPECT_NE(*after[1], hello);
+    EXPECT_TRUE(arena->contains(*after[0]));
+    EXPECT_TRUE(arena->contains(*after[1]));
+
+    compiler.compile(file("Second", "greet\n"));
+    EXPECT_EQ(out.str(), "");
+}
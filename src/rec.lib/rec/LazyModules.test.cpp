@@ -0,0 +1,75 @@
+#include "Compiler.h"
+
+#include "instance/Module.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace rec;
+
+TEST(LazyModules, parsedOnMemberLookup) {
+    auto diagnosticsOut = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &diagnosticsOut;
+    config.lazyModules = true;
+    auto compiler = Compiler{config};
+
+    testing::internal::CaptureStdout();
+    compiler.compile(text::File{
+        strings::String{"TestFile"},
+        strings::String{"Rebuild.Context.declareModule test:\n"
+                        "    Rebuild.say \"parsing test\"\n"
+                        "    Rebuild.Context.declareVariable foo :Rebuild.literal.String = \"Foo\"\n"
+                        "end\n"
+                        "Rebuild.Context.declareModule unused:\n"
+                        "    Rebuild.say \"parsing unused\"\n"
+                        "end\n"}});
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+
+    testing::internal::CaptureStdout();
+    compiler.compile(text::File{strings::String{"TestFile2"}, strings::String{"test.foo\n"}});
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "parsing test\n");
+    EXPECT_EQ(diagnosticsOut.str(), "");
+}
+
+TEST(LazyModules, concurrentLookupsParseOnce) {
+    auto module = instance::Module{};
+    auto parsed = std::atomic<int>{};
+    module.deferBody([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        parsed++;
+    });
+    ASSERT_TRUE(module.hasPendingBody());
+
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i < 4; i++) threads.emplace_back([&] { (void)module.members(); });
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(parsed.load(), 1);
+    EXPECT_FALSE(module.hasPendingBody());
+}
+
+// the body is parsed while the second file is compiled, its diagnostics still name the first file
+TEST(LazyModules, diagnosticsNameTheDeclaringFile) {
+    auto diagnosticsOut = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &diagnosticsOut;
+    config.lazyModules = true;
+    auto compiler = Compiler{config};
+
+    compiler.compile(text::File{
+        strings::String{"Declaring"},
+        strings::String{"Rebuild.Context.declareModule test:\n"
+                        "    Rebuild.say \x80\n"
+                        "end\n"}});
+    EXPECT_EQ(diagnosticsOut.str(), "");
+
+    compiler.compile(text::File{strings::String{"Using"}, strings::String{"test.foo\n"}});
+    EXPECT_NE(diagnosticsOut.str().find("--> Declaring:2"), std::string::npos) << diagnosticsOut.str();
+    EXPECT_EQ(diagnosticsOut.str().find("--> Using"), std::string::npos);
+}
@@ -25,6 +25,7 @@ TEST(LexerErrors, decodeErrors) {
 
 The UTF8-decoder encountered multiple invalid encodings
 
+--> TestFile:1
 1 |\[80] \[e280]x
   |~~~~~ ~~~~~~~
 
@@ -45,6 +46,7 @@ TEST(LexerErrors, unexpectedCharacter) {
 
 The tokenizer encountered multiple characters that are not part of any Rebuild language token.
 
+--> TestFile:1
 1 |\[7] \0
   |~~~~ ~~
 
@@ -65,6 +67,7 @@ TEST(LexerErrors, mixedIndentation) {
 
 The indentation mixes tabs and spaces.
 
+--> TestFile:1
 1 | \n
 2 |\t
   |~~
@@ -86,6 +89,7 @@ TEST(LexerErrors, indentationDecodeError) {
 
 The UTF8-decoder encountered an invalid encoding
 
+--> TestFile:1
 1 | \n
 2 |\[80]
   |~~~~~
@@ -107,6 +111,7 @@ TEST(LexerErrors, unknownEscapeSequence) {
 
 These Escape sequences are unknown.
 
+--> TestFile:1
 1 |"\?"
   | ~~
 
@@ -127,6 +132,7 @@ TEST(LexerErrors, numberMissingBoundary) {
 
 The number literal ends with an unknown suffix.
 
+--> TestFile:1
 1 |3.14p
   |    ~
 
@@ -147,6 +153,7 @@ TEST(LexerErrors, operatorParts) {
 
 There was no opening sign before the closing sign.
 
+--> TestFile:1
 1 |*›‹
   | ~
 
@@ -155,6 +162,7 @@ There was no opening sign before the closing sign.
 
 The operator ends before the closing sign was found.
 
+--> TestFile:1
 1 |*›‹
   |  ~
 
@@ -175,6 +183,7 @@ TEST(LexerErrors, unexpectedColon) {
 
 The colon cannot be the only token on a line.
 
+--> TestFile:2
 2 |:
   |~
 
@@ -195,6 +204,7 @@ TEST(LexerErrors, unexpectedIndent) {
 
 The indentation is above the regular block level, but does not leave the block.
 
+--> TestFile:2
 2 |
 3 |  c
   |~~
@@ -216,6 +226,7 @@ TEST(LexerErrors, unexpectedTokenAfterEnd) {
 
 After end no more tokens are allowed.
 
+--> TestFile:2
 2 |b:
 3 |end+ nx
   |   ~ ~~
@@ -237,6 +248,7 @@ TEST(LexerErrors, unexpectedBlockEnd) {
 
 The end keyword is only allowed to end blocks
 
+--> TestFile:2
 2 |b
 3 | end
   | ~~~
@@ -258,6 +270,7 @@ TEST(LexerErrors, missingBlockEnd) {
 
 The block ended without the end keyword
 
+--> TestFile:1
 1 |b:
 2 |  c
 
@@ -0,0 +1,261 @@
+#include "MemoryReport.h"
+
+#include "instance/Entry.h"
+
+#include <iomanip>
+
+namespace rec {
+
+namespace {
+
+// strings own a vector - there is no inline storage
+auto stringHeap(const strings::String& s) -> uint64_t { return s.byteCapacity().v; }
+
+auto ropeHeap(const strings::Rope& r) -> uint64_t { return r.pieceCapacity() * sizeof(strings::Rope::Data); }
+
+template<class T>
+auto vectorHeap(const std::vector<T>& v) -> uint64_t {
+    return v.capacity() * sizeof(T);
+}
+
+// each node of a std::list stores two pointers
+template<class T>
+auto listHeap(const std::list<T>& l) -> uint64_t {
+    return l.size() * (sizeof(T) + 2 * sizeof(void*));
+}
+
+auto localScopeHeap(const instance::LocalScope& locals) -> uint64_t {
+    auto count = uint64_t{};
+    for ([[maybe_unused]] const auto& entry : locals) count++;
+    return count * sizeof(instance::Entry); // note: capacity is not exposed
+}
+
+// names of the variant alternatives
+auto kindName(const nesting::BlockLiteral&) { return "BlockLiteral"; }
+auto kindName(const nesting::ColonSeparator&) { return "ColonSeparator"; }
+auto kindName(const nesting::CommaSeparator&) { return "CommaSeparator"; }
+auto kindName(const nesting::SquareBracketOpen&) { return "SquareBracketOpen"; }
+auto kindName(const nesting::SquareBracketClose&) { return "SquareBracketClose"; }
+auto kindName(const nesting::BracketOpen&) { return "BracketOpen"; }
+auto kindName(const nesting::BracketClose&) { return "BracketClose"; }
+auto kindName(const nesting::StringLiteral&) { return "StringLiteral"; }
+auto kindName(const nesting::NumberLiteral&) { return "NumberLiteral"; }
+auto kindName(const nesting::IdentifierLiteral&) { return "IdentifierLiteral"; }
+auto kindName(const parser::NameTypeValueReference&) { return "NameTypeValueReference"; }
+auto kindName(const parser::VariableReference&) { return "VariableReference"; }
+auto kindName(const parser::TypeReference&) { return "TypeReference"; }
+auto kindName(const parser::Value&) { return "Value"; }
+auto kindName(const parser::Call&) { return "Call"; }
+auto kindName(const parser::VecOfPartiallyParsed&) { return "PartiallyParsed"; }
+auto kindName(const parser::ModuleReference&) { return "ModuleReference"; }
+auto kindName(const parser::Block&) { return "Block"; }
+auto kindName(const parser::NameTypeValueTuple&) { return "NameTypeValueTuple"; }
+auto kindName(const parser::ModuleInit&) { return "ModuleInit"; }
+auto kindName(const parser::VariableInit&) { return "VariableInit"; }
+
+} // namespace
+
+struct MemoryWalker {
+    MemoryReport& report;
+
+    void node(const std::string& name, uint64_t bytes, uint64_t heapBytes) {
+        auto& usage = report.nodes[name];
+        usage.count++;
+        usage.bytes += bytes;
+        usage.heapBytes += heapBytes;
+    }
+    bool firstVisit(const void* p) { return report.m_visited.insert(p).second; }
+
+    void string(const strings::String& s) {
+        auto size = s.byteCount().v;
+        report.stringBytes += size;
+        if (report.m_strings[std::string(s.begin(), s.end())]++ > 0) report.duplicatedStringBytes += size;
+    }
+    void string(const strings::Rope& r) {
+        auto s = strings::to_string(r);
+        string(s);
+    }
+
+    // nesting
+    void walk(const nesting::BlockLiteralValue& block) {
+        const auto& lines = *block.lines;
+        if (!firstVisit(&lines)) return; // lines are shared between copies
+        node("BlockLines", sizeof(lines), vectorHeap(lines));
+        for (const auto& line : lines) walk(line);
+    }
+    void walk(const nesting::BlockLine& line) {
+        node("BlockLine", sizeof(line), vectorHeap(line.tokens) + vectorHeap(line.insignificants));
+        for (const auto& token : line.tokens) walk(token);
+        for (const auto& insignificant : line.insignificants) node("Insignificant", sizeof(insignificant), 0);
+    }
+    void walk(const nesting::Token& token) {
+        token.visit([&](const auto& t) { node(std::string{"Token."} + kindName(t), sizeof(token), heapOf(t)); });
+        token.visit(
+            [&](const nesting::BlockLiteral& b) { walk(b.value); },
+            [&](const nesting::StringLiteral& s) { string(s.value.text); },
+            [](const auto&) {});
+    }
+    auto heapOf(const nesting::StringLiteral& s) -> uint64_t { return ropeHeap(s.value.text); }
+    auto heapOf(const nesting::NumberLiteral& n) -> uint64_t {
+        return ropeHeap(n.value.integerPart) + ropeHeap(n.value.fractionalPart) + ropeHeap(n.value.exponentPart);
+    }
+    template<class T>
+    auto heapOf(const T&) -> uint64_t {
+        return 0;
+    }
+
+    // parser
+    void walk(const parser::Block& block) {
+        for (const auto& expr : block.expressions) {
+            expr.visit([&](const auto& e) {
+                node(std::string{"BlockExpr."} + kindName(e), sizeof(expr), heapOf(e));
+                walkChildren(e);
+            });
+        }
+    }
+    void walk(const parser::ValueExpr& expr) {
+        expr.visit([&](const auto& e) {
+            node(std::string{"ValueExpr."} + kindName(e), sizeof(expr), heapOf(e));
+            walkChildren(e);
+        });
+    }
+    void walk(const parser::TypeExpr& expr) {
+        expr.visit([&](const auto& e) {
+            node(std::string{"TypeExpr."} + kindName(e), sizeof(expr), heapOf(e));
+            walkChildren(e);
+        });
+    }
+    void walk(const parser::InitExpr& expr) {
+        expr.visit([&](const auto& e) {
+            node(std::string{"InitExpr."} + kindName(e), sizeof(expr), heapOf(e));
+            walkChildren(e);
+        });
+    }
+    void walk(const parser::PartiallyParsed& expr) {
+        expr.visit([&](const auto& e) {
+            node(std::string{"PartiallyParsed."} + kindName(e), sizeof(expr), heapOf(e));
+            walkChildren(e);
+        });
+    }
+    void walk(const parser::NameTypeValue& ntv) {
+        node("NameTypeValue", sizeof(ntv), ntv.name ? stringHeap(ntv.name.value()) : 0);
+        if (ntv.name) string(ntv.name.value());
+        if (ntv.type) walk(ntv.type.value());
+        if (ntv.value) walk(ntv.value.value());
+    }
+
+    auto heapOf(const parser::Block& b) -> uint64_t { return vectorHeap(b.expressions); }
+    auto heapOf(const parser::Call& c) -> uint64_t {
+        auto heap = vectorHeap(c.arguments);
+        for (const auto& a : c.arguments) heap += vectorHeap(a.values);
+        return heap;
+    }
+    auto heapOf(const parser::VecOfPartiallyParsed& v) -> uint64_t { return vectorHeap(v); }
+    auto heapOf(const parser::NameTypeValueTuple& t) -> uint64_t {
+        return firstVisit(&*t.tuple) ? listHeap(*t.tuple) : 0; // tuples are shared between copies
+    }
+    auto heapOf(const parser::ModuleInit& i) -> uint64_t { return vectorHeap(i.nodes); }
+    auto heapOf(const parser::VariableInit& i) -> uint64_t { return vectorHeap(i.nodes); }
+
+    void walkChildren(const parser::Block& b) { walk(b); }
+    void walkChildren(const parser::Call& c) {
+        for (const auto& a : c.arguments)
+            for (const auto& v : a.values) walk(v);
+    }
+    void walkChildren(const parser::VecOfPartiallyParsed& v) {
+        for (const auto& p : v) walk(p);
+    }
+    void walkChildren(const parser::NameTypeValueTuple& t) {
+        for (const auto& ntv : *t.tuple) walk(ntv);
+    }
+    void walkChildren(const parser::ModuleInit& i) {
+        for (const auto& n : i.nodes) walk(n);
+    }
+    void walkChildren(const parser::VariableInit& i) {
+        for (const auto& n : i.nodes) walk(n);
+    }
+    void walkChildren(const parser::Value& value) {
+        auto type = value.type();
+        if (type == nullptr || !firstVisit(value.data())) return; // payload is shared between copies
+        auto name = type->module ? std::string(type->module->name.begin(), type->module->name.end()) : "?";
+        node("Value." + name, type->size, type->size);
+    }
+    void walkChildren(const nesting::IdentifierLiteral&) {}
+    template<class T>
+    void walkChildren(const T&) {}
+
+    // instance
+    void walk(const instance::Scope& scope) {
+        if (!firstVisit(&scope)) return;
+        node("Scope", sizeof(scope), 0);
+        if (scope.locals) walk(*scope.locals);
+        if (scope.parent) walk(*scope.parent);
+    }
+    void walk(const instance::LocalScope& locals) {
+        if (!firstVisit(&locals)) return;
+        node("LocalScope", sizeof(locals), localScopeHeap(locals));
+        for (const auto& entry : locals) walk(entry);
+    }
+    void walk(const instance::Entry& entry) {
+        entry.visit([&](const auto& ptr) {
+            if (!firstVisit(ptr.get())) return;
+            walk(*ptr);
+        });
+    }
+    void walk(const instance::Function& function) {
+        node("Entry.Function", sizeof(instance::Entry) + sizeof(function), stringHeap(function.name));
+        string(function.name);
+        node("LocalScope", sizeof(function.parameterScope), localScopeHeap(function.parameterScope));
+        for (const auto& entry : function.parameterScope) walk(entry);
+        for (const auto& parameter : function.parameters) walk(*parameter);
+        function.body.visit(
+            [&](const instance::ParsedBlock& parsed) {
+                node("LocalScope", sizeof(parsed.locals), localScopeHeap(parsed.locals));
+                for (const auto& entry : parsed.locals) walk(entry);
+                walk(parsed.block);
+            },
+            [](const instance::IntrinsicCall&) {});
+    }
+    void walk(const instance::Parameter& parameter) {
+        node("Parameter", sizeof(parameter), stringHeap(parameter.name) + vectorHeap(parameter.defaultValue));
+        string(parameter.name);
+        walk(parameter.type);
+        for (const auto& value : parameter.defaultValue) walk(value);
+    }
+    void walk(const instance::Variable& variable) {
+        node("Entry.Variable", sizeof(instance::Entry) + sizeof(variable), stringHeap(variable.name));
+        string(variable.name);
+    }
+    void walk(const instance::Type& type) { node("Entry.Type", sizeof(instance::Entry) + sizeof(type), 0); }
+    void walk(const instance::Module& module) {
+        node("Entry.Module", sizeof(instance::Entry) + sizeof(module), stringHeap(module.name));
+        string(module.name);
+        node("LocalScope", sizeof(module.locals), localScopeHeap(module.locals));
+        for (const auto& entry : module.locals) walk(entry);
+    }
+};
+
+void MemoryReport::add(const nesting::BlockLiteral& blockLiteral) { MemoryWalker{*this}.walk(blockLiteral.value); }
+
+void MemoryReport::add(const parser::Block& block) { MemoryWalker{*this}.walk(block); }
+
+void MemoryReport::add(const instance::Scope& scope) { MemoryWalker{*this}.walk(scope); }
+
+auto operator<<(std::ostream& out, const MemoryReport& report) -> std::ostream& {
+    auto total = MemoryUsage{};
+    out << std::left << std::setw(36) << "node" << std::right << std::setw(10) << "count" << std::setw(12) << "bytes"
+        << std::setw(12) << "heap" << '\n';
+    for (const auto& [name, usage] : report.nodes) {
+        out << std::left << std::setw(36) << name << std::right << std::setw(10) << usage.count << std::setw(12)
+            << usage.bytes << std::setw(12) << usage.heapBytes << '\n';
+        total.count += usage.count;
+        total.bytes += usage.bytes;
+        total.heapBytes += usage.heapBytes;
+    }
+    out << std::left << std::setw(36) << "total" << std::right << std::setw(10) << total.count << std::setw(12)
+        << total.bytes << std::setw(12) << total.heapBytes << '\n';
+    out << "strings: " << report.stringBytes << " bytes, duplicated: " << report.duplicatedStringBytes << " bytes\n";
+    return out;
+}
+
+} // namespace rec
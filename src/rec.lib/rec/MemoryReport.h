@@ -0,0 +1,40 @@
+#pragma once
+#include "instance/Scope.h"
+#include "nesting/Token.h"
+#include "parser/Expression.h"
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rec {
+
+/// memory used by all nodes of one kind
+struct MemoryUsage {
+    uint64_t count{};
+    uint64_t bytes{}; ///< sizeof of all nodes
+    uint64_t heapBytes{}; ///< allocations owned by the nodes (includes unused capacity)
+};
+
+/// memory footprint of the compiler data structures
+// shared storage (block lines, value payloads, instances) is counted once
+struct MemoryReport {
+    std::map<std::string, MemoryUsage> nodes{}; ///< keys like "ValueExpr.Call"
+    uint64_t stringBytes{}; ///< bytes of all owned strings
+    uint64_t duplicatedStringBytes{}; ///< bytes of strings that were seen before
+
+    void add(const nesting::BlockLiteral& blockLiteral);
+    void add(const parser::Block& block);
+    void add(const instance::Scope& scope);
+
+private:
+    friend struct MemoryWalker;
+    std::unordered_set<const void*> m_visited{};
+    std::unordered_map<std::string, uint64_t> m_strings{};
+};
+
+auto operator<<(std::ostream& out, const MemoryReport& report) -> std::ostream&;
+
+} // namespace rec
@@ -0,0 +1,41 @@
+#include "Compiler.h"
+#include "MemoryReport.h"
+
+#include "nesting/Token.builder.h"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+using namespace rec;
+using namespace nesting;
+
+TEST(MemoryReport, blockLiteral) {
+    auto inner = blk(line().tokens(id(View{"inner"})));
+    auto outer = BlockLiteral{{}, {buildBlockLines(line().tokens(id(View{"a"}), inner, inner))}};
+
+    auto report = MemoryReport{};
+    report.add(outer);
+
+    EXPECT_EQ(report.nodes["Token.BlockLiteral"].count, 2u);
+    EXPECT_EQ(report.nodes["Token.IdentifierLiteral"].count, 2u); // shared lines are counted once
+    EXPECT_EQ(report.nodes["BlockLine"].count, 2u);
+    EXPECT_EQ(report.nodes["BlockLines"].count, 2u);
+
+    auto out = std::stringstream{};
+    out << report;
+    EXPECT_NE(out.str().find("Token.BlockLiteral"), std::string::npos);
+}
+
+TEST(MemoryReport, compiler) {
+    auto out = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.memoryReportOutput = &out;
+    auto compiler = Compiler{config};
+
+    compiler.compile(text::File{strings::String{"TestFile"}, strings::String{"Rebuild.say \"Hello\"\n"}});
+
+    EXPECT_NE(out.str().find("Memory:"), std::string::npos);
+    EXPECT_NE(out.str().find("Entry.Function"), std::string::npos);
+    EXPECT_NE(out.str().find("Token.StringLiteral"), std::string::npos);
+}
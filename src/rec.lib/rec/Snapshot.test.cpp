@@ -0,0 +1,113 @@
+#include "Compiler.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <sstream>
+
+using namespace rec;
+
+namespace {
+
+auto file(const char* name, const char* content) -> text::File {
+    return text::File{strings::String{name, name + std::strlen(name)},
+                      strings::String{content, content + std::strlen(content)}};
+}
+
+} // namespace
+
+TEST(Snapshot, forksShareThePrelude) {
+    auto preludeOut = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &preludeOut;
+    config.rebuildOutput = &preludeOut;
+    auto prelude = Compiler{config};
+    prelude.compile(file(
+        "Prelude",
+        "Rebuild.Context.declareModule base:\n"
+        "    Rebuild.say \"parsing prelude\"\n"
+        "    Rebuild.Context.declareVariable foo :Rebuild.literal.String = \"Foo\"\n"
+        "end\n"
+        "Rebuild.Context.declareFunction left=() hi () ():\n"
+        "    Rebuild.say \"parsing hi\"\n"
+        "end\n"));
+    auto snapshot = prelude.snapshot();
+    EXPECT_EQ(preludeOut.str(), "parsing prelude\nparsing hi\n");
+
+    auto firstOut = std::stringstream{};
+    config.diagnosticsOutput = &firstOut;
+    config.rebuildOutput = &firstOut;
+    auto first = Compiler{config, snapshot};
+    first.compile(file(
+        "First",
+        "Rebuild.Context.declareModule only:\n"
+        "    Rebuild.Context.declareVariable bar :Rebuild.literal.String = \"Bar\"\n"
+        "end\n"
+        "hi\n"
+        "base.foo\n"
+        "only.bar\n"));
+    EXPECT_EQ(firstOut.str(), ""); // the prelude is not parsed again
+
+    auto secondOut = std::stringstream{};
+    config.diagnosticsOutput = &secondOut;
+    config.rebuildOutput = &secondOut;
+    auto second = Compiler{config, snapshot};
+    second.compile(file("Second", "hi\nbase.foo\n"));
+    EXPECT_EQ(secondOut.str(), "");
+
+    // declarations of a fork stay in the fork
+    auto modules = [](const Compiler& compiler) { return compiler.memoryReport().nodes.at("Entry.Module").count; };
+    EXPECT_EQ(modules(first), modules(second) + 1);
+    EXPECT_EQ(modules(prelude), modules(second));
+}
+
+TEST(Snapshot, outlivesThePrelude) {
+    auto out = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &out;
+    config.rebuildOutput = &out;
+    auto snapshot = [&] {
+        auto prelude = Compiler{config};
+        prelude.compile(file(
+            "Prelude",
+            "Rebuild.Context.declareModule base:\n"
+            "    Rebuild.Context.declareVariable foo :Rebuild.literal.String = \"Foo\"\n"
+            "end\n"));
+        return prelude.snapshot();
+    }();
+
+    auto fork = Compiler{config, snapshot};
+    fork.compile(file("Fork", "base.foo\n"));
+    EXPECT_EQ(out.str(), "");
+    const auto& sources = fork.sourceManager();
+    ASSERT_EQ(sources.fileCount(), 2u);
+    EXPECT_EQ(sources.fileOf(text::SourceLoc{1})->filename, strings::String{"Prelude"}); // shared with the snapshot
+}
+
+// conversions declared in one fork are not visible in others
+TEST(Snapshot, forksKeepTheirConversions) {
+    auto out = std::stringstream{};
+    auto config = Config{text::Column{8}};
+    config.diagnosticsOutput = &out;
+    config.rebuildOutput = &out;
+    auto prelude = Compiler{config};
+    auto snapshot = prelude.snapshot();
+
+    auto sayNumber = [&] {
+        out.str({});
+        auto other = Compiler{config, snapshot};
+        other.compile(file("Other", "Rebuild.say 7\n"));
+        return out.str();
+    };
+    auto before = sayNumber();
+
+    auto declaring = Compiler{config, snapshot};
+    declaring.compile(file(
+        "Declaring",
+        "Rebuild.Context.declareFunction left=() implicitFrom "
+        "(n :Rebuild.literal.Number) (s :Rebuild.literal.String):\n"
+        "    Rebuild.say \"converting\"\n"
+        "end\n"));
+
+    EXPECT_EQ(sayNumber(), before);
+}
@@ -0,0 +1,189 @@
+#include "Workers.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#    include <poll.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+
+#    include <cerrno>
+#    include <csignal>
+#endif
+
+namespace rec {
+
+auto compileIsolated(const Config& config, const Snapshot& snapshot, const TextFile& file) -> std::string {
+    auto out = std::stringstream{};
+    auto fileConfig = config;
+    auto redirect = [&](std::ostream*& stream) {
+        if (stream) stream = &out;
+    };
+    redirect(fileConfig.tokenOutput);
+    redirect(fileConfig.blockOutput);
+    redirect(fileConfig.diagnosticsOutput);
+    redirect(fileConfig.memoryReportOutput);
+    redirect(fileConfig.rebuildOutput);
+    {
+        auto compiler = Compiler{fileConfig, snapshot};
+        compiler.compile(file);
+    } // flushes the output
+    return out.str();
+}
+
+#ifdef _WIN32
+
+auto compileFiles(const Config& config, const Snapshot& snapshot, const TextFiles& files, size_t) -> CompiledFiles {
+    auto compiled = CompiledFiles{};
+    compiled.results.reserve(files.size());
+    for (const auto& file : files) compiled.results.push_back(compileIsolated(config, snapshot, file));
+    return compiled;
+}
+
+#else
+
+namespace {
+
+// frame: file index (uint32) + length (uint64) + bytes
+struct FrameHeader {
+    uint32_t index{};
+    uint64_t length{};
+};
+constexpr auto frameHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        auto written = ::write(fd, data, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool writeFrame(int fd, uint32_t index, const std::string& result) {
+    char header[frameHeaderSize];
+    auto length = uint64_t{result.size()};
+    std::memcpy(header, &index, sizeof(index));
+    std::memcpy(header + sizeof(index), &length, sizeof(length));
+    return writeAll(fd, header, frameHeaderSize) && writeAll(fd, result.data(), result.size());
+}
+
+auto readFrameHeader(const std::string& buffer) -> FrameHeader {
+    auto header = FrameHeader{};
+    std::memcpy(&header.index, buffer.data(), sizeof(header.index));
+    std::memcpy(&header.length, buffer.data() + sizeof(header.index), sizeof(header.length));
+    return header;
+}
+
+struct Worker {
+    pid_t pid{};
+    int fd{-1};
+    std::string buffer{}; // bytes of incomplete frames
+};
+
+// the child only writes to its pipe and leaves without running any destructors of the parent state
+[[noreturn]] void runWorker(
+    const Config& config, const Snapshot& snapshot, const TextFiles& files, size_t first, size_t step, int fd) {
+    auto workerConfig = config;
+    workerConfig.callCache = nullptr; // the cache state of the parent is not shared
+    for (auto i = first; i < files.size(); i += step) {
+        if (!writeFrame(fd, static_cast<uint32_t>(i), compileIsolated(workerConfig, snapshot, files[i]))) break;
+    }
+    ::close(fd);
+    ::_exit(0);
+}
+
+} // namespace
+
+auto compileFiles(const Config& config, const Snapshot& snapshot, const TextFiles& files, size_t workers)
+    -> CompiledFiles {
+    auto compiled = CompiledFiles{};
+    auto& results = compiled.results;
+    results.resize(files.size());
+    auto done = std::vector<bool>(files.size());
+    if (workers > files.size()) workers = files.size();
+    if (config.callThreads > 1) workers = 1; // the threads of the task pools would be missing in the children
+
+    auto running = std::vector<Worker>{};
+    if (workers > 1) {
+        std::cout.flush(); // buffered output would be written by every child
+        std::cerr.flush();
+        for (auto w = size_t{}; w < workers; w++) {
+            int fds[2];
+            if (::pipe(fds) != 0) break;
+            auto pid = ::fork();
+            if (pid == 0) {
+                ::close(fds[0]);
+                for (auto& other : running) ::close(other.fd);
+                runWorker(config, snapshot, files, w, workers, fds[1]);
+            }
+            ::close(fds[1]);
+            if (pid < 0) {
+                ::close(fds[0]);
+                break;
+            }
+            running.push_back(Worker{pid, fds[0]});
+        }
+        if (running.size() < workers) {
+            // fork failed - everything is compiled here
+            for (auto& worker : running) {
+                ::kill(worker.pid, SIGTERM);
+                ::close(worker.fd);
+                ::waitpid(worker.pid, nullptr, 0);
+            }
+            running.clear();
+        }
+    }
+
+    auto remaining = running.size();
+    while (remaining > 0) {
+        auto polls = std::vector<pollfd>{};
+        for (auto& worker : running) polls.push_back(pollfd{worker.fd, POLLIN, 0});
+        if (::poll(polls.data(), polls.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (auto w = size_t{}; w < running.size(); w++) {
+            auto& worker = running[w];
+            if (worker.fd < 0 || polls[w].revents == 0) continue;
+            char chunk[64 * 1024];
+            auto count = ::read(worker.fd, chunk, sizeof(chunk));
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) {
+                ::close(worker.fd);
+                worker.fd = -1;
+                remaining--;
+                continue;
+            }
+            worker.buffer.append(chunk, static_cast<size_t>(count));
+            while (worker.buffer.size() >= frameHeaderSize) {
+                auto header = readFrameHeader(worker.buffer);
+                if (worker.buffer.size() < frameHeaderSize + header.length) break;
+                if (header.index < results.size() && !done[header.index]) {
+                    results[header.index] = worker.buffer.substr(frameHeaderSize, header.length);
+                    done[header.index] = true;
+                    compiled.forked++;
+                }
+                worker.buffer.erase(0, frameHeaderSize + header.length);
+            }
+        }
+    }
+    for (auto& worker : running) {
+        if (worker.fd >= 0) ::close(worker.fd);
+        ::waitpid(worker.pid, nullptr, 0);
+    }
+
+    // serial mode and files of workers that failed
+    for (auto i = size_t{}; i < files.size(); i++) {
+        if (!done[i]) results[i] = compileIsolated(config, snapshot, files[i]);
+    }
+    return compiled;
+}
+
+#endif
+
+} // namespace rec
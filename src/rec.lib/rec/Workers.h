@@ -0,0 +1,28 @@
+#pragma once
+#include "Compiler.h"
+
+#include <string>
+#include <vector>
+
+namespace rec {
+
+using TextFiles = std::vector<TextFile>;
+
+/// compiles the file in a fresh fork of the snapshot
+// returns everything the compiler printed (compile time output and diagnostics)
+[[nodiscard]] auto compileIsolated(const Config& config, const Snapshot& snapshot, const TextFile& file)
+    -> std::string;
+
+struct CompiledFiles {
+    std::vector<std::string> results{}; ///< output of each file - in the order of the files
+    size_t forked{}; ///< number of files compiled by worker processes - the others were compiled here
+};
+
+/// compiles every file isolated on top of the snapshot
+// workers > 1 forks worker processes that share the snapshot through copy-on-write pages (POSIX only)
+// every worker compiles each n-th file and streams the results back through its own pipe
+// note: a fork only copies the calling thread - with config.callThreads > 1 everything is compiled here
+[[nodiscard]] auto compileFiles(const Config& config, const Snapshot& snapshot, const TextFiles& files, size_t workers)
+    -> CompiledFiles;
+
+} // namespace rec
@@ -0,0 +1,52 @@
+#include "Workers.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+using namespace rec;
+
+namespace {
+
+auto file(const char* name, const char* content) -> text::File {
+    return text::File{strings::String{name, name + std::strlen(name)},
+                      strings::String{content, content + std::strlen(content)}};
+}
+
+} // namespace
+
+TEST(Workers, forkedResultsMatchSerial) {
+    auto config = Config{text::Column{8}};
+    config.rebuildOutput = nullptr;
+    auto prelude = Compiler{config};
+    prelude.compile(file(
+        "Prelude",
+        "Rebuild.Context.declareFunction left=() hi () ():\n"
+        "    Rebuild.say \"parsing hi\"\n"
+        "end\n"));
+    auto snapshot = prelude.snapshot();
+
+    config.rebuildOutput = &std::cout; // redirected into the results
+    config.diagnosticsOutput = &std::cout;
+    auto files = TextFiles{
+        file("A", "Rebuild.say \"a\"\nhi\n"),
+        file("B", "Rebuild.say \"b\"\n"),
+        file("C", "Rebuild.say \"c\"\nhi\n"),
+        file("D", "Rebuild.say \"d\"\n"),
+        file("E", "Rebuild.say \"e\"\n"),
+    };
+    auto serial = compileFiles(config, snapshot, files, 1);
+    EXPECT_EQ(serial.results, (std::vector<std::string>{"a\n", "b\n", "c\n", "d\n", "e\n"}));
+    EXPECT_EQ(serial.forked, 0u);
+
+    auto forked = compileFiles(config, snapshot, files, 3);
+    EXPECT_EQ(forked.results, serial.results);
+#ifndef _WIN32
+    EXPECT_EQ(forked.forked, files.size()); // every file was compiled by a worker
+#endif
+
+    config.callThreads = 2;
+    auto threaded = compileFiles(config, snapshot, files, 3);
+    EXPECT_EQ(threaded.results, serial.results);
+    EXPECT_EQ(threaded.forked, 0u); // no forks while task pools run threads
+}
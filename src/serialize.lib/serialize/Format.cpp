@@ -0,0 +1,198 @@
+#include "Format.h"
+
+#include "Reader.h"
+#include "Symbols.h"
+#include "nesting.h"
+#include "parser.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace serialize {
+
+namespace {
+
+// header:
+// magic "rec" - formatVersion - kind - source size - source hash
+constexpr uint8_t magic[] = {'r', 'e', 'c'};
+
+enum class Kind : uint8_t {
+    BlockLiteral = 1,
+    Block = 2,
+    Call = 3,
+    ValueExpr = 4,
+};
+
+auto sourceHash(View source) -> uint64_t {
+    return std::hash<std::string_view>{}(std::string_view{source.begin(), source.size()});
+}
+
+void writeHeader(Writer& w, Kind kind) {
+    for (auto m : magic) w.byte(m);
+    w.byte(formatVersion);
+    w.enumValue(kind);
+    w.varint(w.source().size());
+    w.varint(sourceHash(w.source()));
+}
+
+bool readHeader(Reader& r, Kind kind, View source) {
+    for (auto m : magic) {
+        if (r.byte() != m) return false;
+    }
+    if (r.byte() != formatVersion) return false;
+    if (r.enumValue<Kind>() != kind) return false;
+    if (r.varint() != source.size()) return false;
+    if (r.varint() != sourceHash(source)) return false;
+    return !r.failed();
+}
+
+auto viewBytes(const Bytes& bytes) -> View {
+    auto begin = reinterpret_cast<const char*>(bytes.data());
+    return View{begin, begin + bytes.size()};
+}
+
+using Callees = std::vector<instance::FunctionView>; // in order of discovery
+
+enum class Reach : bool { calls, bodies }; // bodies: follow the bodies of the called functions
+
+void collectCallees(const parser::Call& call, Callees& callees, Reach reach);
+
+void collectCallees(const parser::ValueExpr& expr, Callees& callees, Reach reach) {
+    expr.visitSome(
+        [&](const parser::Call& call) { collectCallees(call, callees, reach); },
+        [&](const parser::NameTypeValueTuple& tuple) {
+            for (const auto& entry : *tuple.tuple)
+                if (entry.value) collectCallees(entry.value.value(), callees, reach);
+        });
+}
+
+void collectCallees(const parser::Block& block, Callees& callees, Reach reach) {
+    for (const auto& expr : block.expressions) {
+        expr.visitSome(
+            [&](const parser::Call& call) { collectCallees(call, callees, reach); },
+            [&](const parser::Block& nested) { collectCallees(nested, callees, reach); },
+            [&](const parser::VariableInit& init) {
+                for (const auto& node : init.nodes) collectCallees(node, callees, reach);
+            },
+            [&](const parser::NameTypeValueTuple& tuple) {
+                for (const auto& entry : *tuple.tuple)
+                    if (entry.value) collectCallees(entry.value.value(), callees, reach);
+            });
+    }
+}
+
+void collectCallees(instance::FunctionView function, Callees& callees, Reach reach) {
+    if (std::find(callees.begin(), callees.end(), function) != callees.end()) return;
+    callees.push_back(function);
+    if (reach == Reach::bodies)
+        function->body.visitSome(
+            [&](const instance::ParsedBlock& parsed) { collectCallees(parsed.block, callees, reach); });
+}
+
+void collectCallees(const parser::Call& call, Callees& callees, Reach reach) {
+    collectCallees(call.function, callees, reach);
+    for (const auto& assign : call.arguments)
+        for (const auto& value : assign.values) collectCallees(value, callees, reach);
+}
+
+// two independent 64 bit hashes - a collision would return the result of another call
+auto digestOf(View bytes) -> BodyDigest {
+    auto fnv = uint64_t{0xcbf29ce484222325};
+    for (auto c : bytes) fnv = (fnv ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    return BodyDigest{{fnv, std::hash<std::string_view>{}(std::string_view{bytes.begin(), bytes.size()})}};
+}
+
+// the bodies are serialized once per symbols - later keys only add the digest
+auto bodyDigest(instance::FunctionView function, const Symbols& symbols) -> OptBodyDigest {
+    return symbols.bodyDigest(function, [&]() -> OptBodyDigest {
+        auto w = Writer{View{}, &symbols};
+        auto callees = Callees{};
+        collectCallees(function, callees, Reach::bodies);
+        for (const auto* callee : callees) {
+            callee->body.visit(
+                [&](const instance::ParsedBlock& parsed) {
+                    w.byte(1);
+                    write(w, parsed.block);
+                },
+                [&](const instance::IntrinsicCall&) { w.byte(0); });
+        }
+        if (w.failed()) return {};
+        auto bytes = std::move(w).take();
+        return digestOf(viewBytes(bytes));
+    });
+}
+
+} // namespace
+
+auto saveBlockLiteral(const nesting::BlockLiteral& block, View source) -> Bytes {
+    auto w = Writer{source};
+    writeHeader(w, Kind::BlockLiteral);
+    write(w, block);
+    return std::move(w).take();
+}
+
+auto loadBlockLiteral(const Bytes& bytes, View source) -> meta::Optional<nesting::BlockLiteral> {
+    auto r = Reader{viewBytes(bytes), source};
+    if (!readHeader(r, Kind::BlockLiteral, source)) return {};
+    auto block = read<nesting::BlockLiteral>(r);
+    if (r.failed() || !r.atEnd()) return {};
+    return block;
+}
+
+auto saveBlock(const parser::Block& block, View source, const instance::Scope& scope) -> meta::Optional<Bytes> {
+    auto symbols = Symbols{scope};
+    auto w = Writer{source, &symbols};
+    writeHeader(w, Kind::Block);
+    write(w, block);
+    if (w.failed()) return {};
+    return std::move(w).take();
+}
+
+auto loadBlock(const Bytes& bytes, View source, const instance::Scope& scope) -> meta::Optional<parser::Block> {
+    auto r = Reader{viewBytes(bytes), source, &scope};
+    if (!readHeader(r, Kind::Block, source)) return {};
+    auto block = read<parser::Block>(r);
+    if (r.failed() || !r.atEnd()) return {};
+    return block;
+}
+
+// views are stored inline, the key does not depend on any source file
+// a changed body of any reached function changes the key - intrinsics are identified by their symbol
+// the build of the compiler is part of the keys of the CallCache
+auto saveCall(const parser::Call& call, const Symbols& symbols) -> meta::Optional<Bytes> {
+    auto w = Writer{View{}, &symbols};
+    writeHeader(w, Kind::Call);
+    write(w, call);
+    auto callees = Callees{};
+    collectCallees(call, callees, Reach::calls);
+    for (const auto* callee : callees) {
+        auto digest = bodyDigest(callee, symbols);
+        if (!digest) return {};
+        for (auto v : digest.value().v) w.varint(v);
+    }
+    if (w.failed()) return {};
+    return std::move(w).take();
+}
+
+auto saveValueExpr(const parser::OptValueExpr& expr, const Symbols& symbols) -> meta::Optional<Bytes> {
+    auto w = Writer{View{}, &symbols};
+    writeHeader(w, Kind::ValueExpr);
+    write(w, expr);
+    if (w.failed()) return {};
+    return std::move(w).take();
+}
+
+auto loadValueExpr(const Bytes& bytes, const instance::Scope& scope) -> meta::Optional<parser::OptValueExpr> {
+    return loadValueExpr(viewBytes(bytes), scope);
+}
+
+auto loadValueExpr(View bytes, const instance::Scope& scope) -> meta::Optional<parser::OptValueExpr> {
+    auto r = Reader{bytes, View{}, &scope};
+    if (!readHeader(r, Kind::ValueExpr, View{})) return {};
+    auto expr = read<parser::OptValueExpr>(r);
+    if (r.failed() || !r.atEnd()) return {};
+    return expr;
+}
+
+} // namespace serialize
@@ -0,0 +1,41 @@
+#pragma once
+#include "Writer.h"
+
+#include "nesting/Token.h"
+#include "parser/Expression.h"
+
+#include "meta/Optional.h"
+
+namespace instance {
+struct Scope;
+}
+
+namespace serialize {
+
+/// increment whenever the encoding of any serializer changes
+constexpr auto formatVersion = uint8_t{2};
+
+/// binary block literal - only valid for the exact same source text
+auto saveBlockLiteral(const nesting::BlockLiteral& block, View source) -> Bytes;
+/// returns nothing if bytes are invalid or were saved for another source
+// note: inline views point into bytes
+auto loadBlockLiteral(const Bytes& bytes, View source) -> meta::Optional<nesting::BlockLiteral>;
+
+/// binary parsed block - all referenced instances have to be reachable from scope
+// returns nothing if block refers to an unreachable instance or a value without serializer
+auto saveBlock(const parser::Block& block, View source, const instance::Scope& scope) -> meta::Optional<Bytes>;
+/// returns nothing if bytes are invalid or symbols cannot be resolved in scope
+auto loadBlock(const Bytes& bytes, View source, const instance::Scope& scope) -> meta::Optional<parser::Block>;
+
+/// key of a compile time call - function, all arguments and the bodies of every function the call reaches
+// bodies enter as digests memoized by the symbols
+// returns nothing if the call refers to an unreachable instance or a value without serializer
+auto saveCall(const parser::Call& call, const Symbols& symbols) -> meta::Optional<Bytes>;
+
+/// binary value expression (eg. the result of a compile time call)
+auto saveValueExpr(const parser::OptValueExpr& expr, const Symbols& symbols) -> meta::Optional<Bytes>;
+/// note: inline views point into bytes
+auto loadValueExpr(const Bytes& bytes, const instance::Scope& scope) -> meta::Optional<parser::OptValueExpr>;
+auto loadValueExpr(View bytes, const instance::Scope& scope) -> meta::Optional<parser::OptValueExpr>;
+
+} // namespace serialize
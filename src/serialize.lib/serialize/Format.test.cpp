@@ -0,0 +1,186 @@
+#include "serialize/Format.h"
+#include "serialize/Symbols.h"
+#include "serialize/parser.h"
+
+#include "filter/filterTokens.h"
+#include "nesting/nestTokens.h"
+#include "scanner/tokenize.h"
+#include "strings/utf8Decode.h"
+#include "text/decodePosition.h"
+
+#include "parser/Expression.builder.h"
+#include "parser/Expression.ostream.h"
+
+#include "nesting/Token.builder.h"
+#include "nesting/Token.ostream.h"
+
+#include "instance/Function.builder.h"
+#include "instance/Scope.builder.h"
+#include "instance/Type.builder.h"
+
+#include "gtest/gtest.h"
+
+using namespace parser;
+
+namespace {
+
+auto lex(strings::View source) -> nesting::BlockLiteral {
+    auto config = text::Config{text::Column{8}};
+    return nesting::nestTokens(
+        filter::filterTokens(scanner::tokenize(text::decodePosition(strings::utf8Decode(source), config))));
+}
+
+auto typeOf(instance::Scope& scope, strings::View name) -> const instance::TypePtr& {
+    auto& m = scope.byName(name).frontValue().get<instance::ModulePtr>();
+    return m->locals.byName(strings::View{"type"}).frontValue().get<instance::TypePtr>();
+}
+
+} // namespace
+
+TEST(serialize, blockLiteral) {
+    const auto source = strings::View{"print 1 \"text\"\n    nested 0x2a\n# comment\nsum(a, b)\n"};
+    const auto block = lex(source);
+
+    const auto bytes = serialize::saveBlockLiteral(block, source);
+    const auto loaded = serialize::loadBlockLiteral(bytes, source);
+
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded.value(), block); // views point into the same source
+}
+
+TEST(serialize, blockLiteralOtherSource) {
+    const auto source = strings::View{"print 1\n"};
+    const auto other = strings::View{"print 2\n"};
+    const auto bytes = serialize::saveBlockLiteral(lex(source), source);
+
+    ASSERT_FALSE(serialize::loadBlockLiteral(bytes, other));
+    ASSERT_FALSE(serialize::loadBlockLiteral(serialize::Bytes{bytes.begin(), bytes.end() - 1}, source));
+}
+
+TEST(serialize, block) {
+    auto scope = instance::Scope{};
+    instance::buildScope(
+        scope,
+        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+        instance::fun("print").runtime().params(instance::param("v").type(type("NumLit"))));
+    serialize::registerType<nesting::NumberLiteral>(typeOf(scope, strings::View{"NumLit"}));
+
+    auto block = Block{};
+    block.expressions.emplace_back(parser::buildBlockExpr(
+        scope, parser::call("print").right(arg("v", parser::valueExpr(nesting::num("1")).typeName("NumLit")))));
+
+    const auto source = strings::View{"print 1\n"};
+    const auto bytes = serialize::saveBlock(block, source, scope);
+    ASSERT_TRUE(bytes);
+
+    const auto loaded = serialize::loadBlock(bytes.value(), source, scope);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded.value(), block);
+}
+
+TEST(serialize, blockUnreachable) {
+    auto scope = instance::Scope{};
+    instance::buildScope(scope, instance::fun("print").runtime());
+
+    auto block = Block{};
+    block.expressions.emplace_back(parser::buildBlockExpr(scope, parser::call("print")));
+
+    const auto source = strings::View{"print\n"};
+    ASSERT_TRUE(serialize::saveBlock(block, source, scope));
+    ASSERT_FALSE(serialize::saveBlock(block, source, instance::Scope{})); // function is unknown
+}
+
+TEST(serialize, callKeyAndResult) {
+    auto scope = instance::Scope{};
+    instance::buildScope(
+        scope,
+        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+        instance::fun("twice").runtime().params(instance::param("v").type(type("NumLit"))));
+    serialize::registerType<nesting::NumberLiteral>(typeOf(scope, strings::View{"NumLit"}));
+    const auto symbols = serialize::Symbols{scope};
+
+    auto callOf = [&]<size_t N>(const char (&number)[N]) {
+        return parser::call("twice")
+            .right(arg("v", parser::valueExpr(nesting::num(number)).typeName("NumLit")))
+            .build(scope);
+    };
+    const auto key = serialize::saveCall(callOf("1"), symbols);
+    ASSERT_TRUE(key);
+    ASSERT_EQ(serialize::saveCall(callOf("1"), symbols), key); // same source and arguments
+    ASSERT_NE(serialize::saveCall(callOf("2"), symbols), key);
+
+    const auto result = OptValueExpr{parser::valueExpr(nesting::num("2")).typeName("NumLit").build(scope)};
+    const auto bytes = serialize::saveValueExpr(result, symbols);
+    ASSERT_TRUE(bytes);
+
+    const auto loaded = serialize::loadValueExpr(bytes.value(), scope);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded.value(), result);
+}
+
+// a changed body of any function the call reaches changes the key of the next compile
+TEST(serialize, callKeyCoversCallees) {
+    auto scope = instance::Scope{};
+    instance::buildScope(
+        scope,
+        instance::fun("outer").runtime(),
+        instance::fun("middle").runtime(),
+        instance::fun("leafA").runtime(),
+        instance::fun("leafB").runtime());
+    const auto symbols = serialize::Symbols{scope};
+    auto functionOf = [&]<size_t N>(const char (&name)[N]) {
+        return scope.byName(strings::View{name}).frontValue().get<instance::FunctionPtr>();
+    };
+    auto callingBody = [&]<size_t N>(const char (&name)[N]) {
+        auto parsed = instance::ParsedBlock{};
+        parsed.block.expressions.emplace_back(parser::buildBlockExpr(scope, parser::call(name)));
+        return instance::Body{std::move(parsed)};
+    };
+    functionOf("outer")->body = callingBody("middle");
+    const auto call = parser::call("outer").build(scope);
+
+    functionOf("middle")->body = callingBody("leafA");
+    const auto key = serialize::saveCall(call, symbols);
+    ASSERT_TRUE(key);
+
+    functionOf("middle")->body = callingBody("leafB");
+    ASSERT_EQ(serialize::saveCall(call, symbols), key); // digests are computed once per symbols
+    ASSERT_NE(serialize::saveCall(call, serialize::Symbols{scope}), key);
+}
+
+TEST(serialize, nameTypeValueReference) {
+    auto scope = instance::Scope{};
+    instance::buildScope(
+        scope,
+        instance::typeModT<nesting::NumberLiteral>("NumLit"),
+        instance::fun("print").runtime().params(instance::param("v").type(type("NumLit"))));
+    serialize::registerType<nesting::NumberLiteral>(typeOf(scope, strings::View{"NumLit"}));
+
+    auto block = Block{};
+    auto tuple = NameTypeValueTuple{};
+    auto& defined = tuple.tuple.modify().emplace_back();
+    defined.name = strings::String{"a"};
+    defined.value = parser::valueExpr(nesting::num("1")).typeName("NumLit").build(scope);
+    block.expressions.emplace_back(std::move(tuple));
+
+    const auto& entry = block.expressions.front().get<NameTypeValueTuple>().tuple->front();
+    auto call = parser::call("print").build(scope);
+    const auto* parameter = call.function->parameters.front().get();
+    call.arguments.push_back(ArgumentAssignment{parameter, {NameTypeValueReference{&entry}}});
+    block.expressions.emplace_back(std::move(call));
+
+    const auto source = strings::View{"print a\n"};
+    const auto bytes = serialize::saveBlock(block, source, scope);
+    ASSERT_TRUE(bytes);
+
+    const auto loaded = serialize::loadBlock(bytes.value(), source, scope);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded.value(), block);
+
+    // the reference points into the loaded tuple and the value is restored
+    const auto& loadedEntry = loaded.value().expressions.front().get<NameTypeValueTuple>().tuple->front();
+    const auto& loadedCall = loaded.value().expressions.back().get<Call>();
+    const auto& reference = loadedCall.arguments.front().values.front().get<NameTypeValueReference>();
+    ASSERT_EQ(reference.nameTypeValue, &loadedEntry);
+    ASSERT_EQ(loadedEntry.value, defined.value);
+}
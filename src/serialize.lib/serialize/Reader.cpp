@@ -0,0 +1,69 @@
+#include "Reader.h"
+
+namespace serialize {
+
+auto Reader::byte() -> uint8_t {
+    if (m_input.isEmpty()) {
+        fail();
+        return {};
+    }
+    auto result = static_cast<uint8_t>(*m_input.begin());
+    m_input = View{m_input.begin() + 1, m_input.end()};
+    return result;
+}
+
+auto Reader::varint() -> uint64_t {
+    auto result = uint64_t{};
+    for (auto shift = 0u; shift < 64u; shift += 7u) {
+        auto b = byte();
+        result |= static_cast<uint64_t>(b & 0x7fu) << shift;
+        if ((b & 0x80u) == 0) return result;
+    }
+    fail(); // overlong encoding
+    return {};
+}
+
+auto Reader::bytes() -> View {
+    auto size = varint();
+    if (size > m_input.size()) {
+        fail();
+        return {};
+    }
+    auto result = View{m_input.begin(), m_input.begin() + size};
+    m_input = View{result.end(), m_input.end()};
+    return result;
+}
+
+auto Reader::view() -> View {
+    switch (byte()) {
+    case 0: return {};
+    case 1: {
+        auto offset = varint();
+        auto size = varint();
+        if (offset > m_source.size() || size > m_source.size() - offset) break;
+        return View{m_source.begin() + offset, m_source.begin() + offset + size};
+    }
+    case 2: return bytes();
+    }
+    fail();
+    return {};
+}
+
+auto Reader::count() -> uint64_t {
+    auto result = varint();
+    if (result > m_input.size()) {
+        fail();
+        return {};
+    }
+    return result;
+}
+
+auto Reader::reference(uint64_t index) -> const void* {
+    if (index >= m_references.size()) {
+        fail();
+        return {};
+    }
+    return m_references[index];
+}
+
+} // namespace serialize
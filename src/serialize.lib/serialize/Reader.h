@@ -0,0 +1,59 @@
+#pragma once
+#include "strings/View.h"
+
+#include <cinttypes>
+#include <vector>
+
+namespace instance {
+struct Scope;
+}
+
+namespace serialize {
+
+using strings::View;
+
+/// decodes the format of the Writer
+// inline views point into the input bytes - keep them alive as long as the result is used
+struct Reader {
+    using This = Reader;
+
+    explicit Reader(View input, View source, const instance::Scope* scope = {})
+        : m_input(input)
+        , m_source(source)
+        , m_scope(scope) {}
+
+    auto byte() -> uint8_t;
+    auto varint() -> uint64_t;
+    auto flag() -> bool { return byte() != 0; }
+    auto bytes() -> View;
+    auto view() -> View;
+
+    template<class E>
+    auto enumValue() -> E {
+        return static_cast<E>(varint());
+    }
+
+    /// guards counts against corrupted input (every element takes at least one byte)
+    auto count() -> uint64_t;
+
+    void defineReference(const void* target) { m_references.push_back(target); }
+    [[nodiscard]] auto reference(uint64_t index) -> const void*;
+
+    [[nodiscard]] auto scope() const -> const instance::Scope* { return m_scope; }
+    [[nodiscard]] bool atEnd() const { return m_input.isEmpty(); }
+
+    void fail() {
+        m_failed = true;
+        m_input = {};
+    }
+    [[nodiscard]] bool failed() const { return m_failed; }
+
+private:
+    View m_input{};
+    View m_source{};
+    const instance::Scope* m_scope{};
+    std::vector<const void*> m_references{};
+    bool m_failed{};
+};
+
+} // namespace serialize
@@ -0,0 +1,153 @@
+#pragma once
+#include "Reader.h"
+#include "Writer.h"
+
+#include "strings/Rope.h"
+#include "strings/String.h"
+#include "text/Position.h"
+
+#include "meta/Optional.h"
+#include "meta/Variant.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace serialize {
+
+/// specialize this to make a type serializable
+// struct Serializer<T> {
+//     static void write(Writer&, const T&);
+//     static auto read(Reader&) -> T;
+// };
+template<class T, class = void>
+struct Serializer;
+
+template<class T, class = void>
+constexpr bool is_serializable = false;
+template<class T>
+constexpr bool is_serializable<T, std::void_t<decltype(sizeof(Serializer<T>))>> = true;
+
+template<class T>
+void write(Writer& w, const T& v) {
+    Serializer<T>::write(w, v);
+}
+
+template<class T>
+auto read(Reader& r) -> T {
+    return Serializer<T>::read(r);
+}
+
+template<class T>
+struct Serializer<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+    static void write(Writer& w, T v) { w.varint(static_cast<uint64_t>(v)); }
+    static auto read(Reader& r) -> T { return static_cast<T>(r.varint()); }
+};
+
+template<>
+struct Serializer<strings::View> {
+    static void write(Writer& w, const strings::View& v) { w.view(v); }
+    static auto read(Reader& r) -> strings::View { return r.view(); }
+};
+
+template<>
+struct Serializer<strings::String> {
+    static void write(Writer& w, const strings::String& s) { w.bytes(strings::View{s}); }
+    static auto read(Reader& r) -> strings::String {
+        auto v = r.bytes();
+        return {v.begin(), v.end()};
+    }
+};
+
+// note: pieces are not preserved, the content is read back as a view into the input
+template<>
+struct Serializer<strings::Rope> {
+    static void write(Writer& w, const strings::Rope& rope) {
+        auto content = strings::to_string(rope);
+        w.bytes(strings::View{content});
+    }
+    static auto read(Reader& r) -> strings::Rope {
+        auto rope = strings::Rope{};
+        rope += r.bytes();
+        return rope;
+    }
+};
+
+template<>
+struct Serializer<text::Position> {
+    static void write(Writer& w, const text::Position& p) {
+        w.varint(p.line.v);
+        w.varint(p.column.v);
+    }
+    static auto read(Reader& r) -> text::Position {
+        auto line = text::Line{static_cast<uint32_t>(r.varint())};
+        auto column = text::Column{static_cast<uint32_t>(r.varint())};
+        return {line, column};
+    }
+};
+
+template<>
+struct Serializer<text::Column> {
+    static void write(Writer& w, const text::Column& c) { w.varint(c.v); }
+    static auto read(Reader& r) -> text::Column { return text::Column{static_cast<uint32_t>(r.varint())}; }
+};
+
+template<class T>
+struct Serializer<std::vector<T>> {
+    static void write(Writer& w, const std::vector<T>& vec) {
+        w.varint(vec.size());
+        for (const auto& e : vec) serialize::write(w, e);
+    }
+    static auto read(Reader& r) -> std::vector<T> {
+        auto result = std::vector<T>{};
+        auto count = r.count();
+        result.reserve(count);
+        for (auto i = uint64_t{}; i < count && !r.failed(); i++) result.push_back(serialize::read<T>(r));
+        return result;
+    }
+};
+
+template<class T>
+struct Serializer<meta::Optional<T>> {
+    using Optional = meta::Optional<T>;
+    using Value = std::remove_const_t<std::remove_reference_t<decltype(std::declval<const Optional&>().value())>>;
+
+    static void write(Writer& w, const Optional& opt) {
+        w.flag(static_cast<bool>(opt));
+        if (opt) serialize::write(w, opt.value());
+    }
+    static auto read(Reader& r) -> Optional {
+        if (!r.flag()) return {};
+        return Optional{serialize::read<Value>(r)};
+    }
+};
+
+template<class... Ts>
+struct Serializer<meta::Variant<Ts...>> {
+    using Variant = meta::Variant<Ts...>;
+
+    static void write(Writer& w, const Variant& var) {
+        w.varint(var.index().value());
+        var.visit([&](const auto& v) { serialize::write(w, v); });
+    }
+    static auto read(Reader& r) -> Variant { return readIndex(r, r.varint(), std::index_sequence_for<Ts...>{}); }
+
+private:
+    template<size_t... I>
+    static auto readIndex(Reader& r, uint64_t index, std::index_sequence<I...>) -> Variant {
+        auto result = Variant{};
+        auto found =
+            ((index == I ? (result = Variant{std::in_place_type<Ts>, serialize::read<Ts>(r)}, true) : false) || ...);
+        if (!found) r.fail();
+        return result;
+    }
+};
+
+/// serializer for types derived from a variant (as they are used to allow forward declarations)
+template<class T, class Variant>
+struct DerivedVariantSerializer {
+    static void write(Writer& w, const T& v) { serialize::write<Variant>(w, v); }
+    static auto read(Reader& r) -> T { return T{serialize::read<Variant>(r)}; }
+};
+
+} // namespace serialize
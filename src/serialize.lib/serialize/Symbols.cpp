@@ -0,0 +1,173 @@
+#include "Symbols.h"
+
+#include <algorithm>
+
+namespace serialize {
+
+namespace {
+
+auto withStep(const SymbolPath& prefix, instance::NameView name, uint64_t index, SymbolKind kind = SymbolKind::entry)
+    -> SymbolPath {
+    auto path = prefix;
+    path.steps.push_back(SymbolStep{strings::to_string(name), index});
+    path.kind = kind;
+    return path;
+}
+
+auto nth(const instance::ConstEntryRange& range, uint64_t index) -> const instance::Entry* {
+    auto it = range.begin();
+    for (; it != range.end() && index > 0; ++it, --index) {}
+    return it != range.end() ? &*it : nullptr;
+}
+
+// entries are ordered by name, so overloads are adjacent
+template<class F>
+void forEachEntry(const instance::LocalScope& locals, F&& f) {
+    auto index = uint64_t{};
+    const instance::Entry* previous = nullptr;
+    for (const auto& entry : locals) {
+        auto name = instance::nameOf(entry);
+        index = previous != nullptr && name.isContentEqual(instance::nameOf(*previous)) ? index + 1 : 0;
+        previous = &entry;
+        f(entry, name, index);
+    }
+}
+
+auto isResolved(const ResolvedSymbol& symbol, SymbolKind kind) -> bool {
+    return symbol.kind == kind && (symbol.entry != nullptr || symbol.parameter != nullptr);
+}
+
+auto readResolved(Reader& r) -> ResolvedSymbol {
+    auto path = serialize::read<SymbolPath>(r);
+    if (r.failed() || r.scope() == nullptr) return {};
+    return resolveSymbol(*r.scope(), path);
+}
+
+template<class T>
+auto readEntry(Reader& r) -> const T* {
+    auto symbol = readResolved(r);
+    if (!isResolved(symbol, SymbolKind::entry) || !symbol.entry->holds<std::shared_ptr<T>>()) {
+        r.fail();
+        return nullptr;
+    }
+    return symbol.entry->get(meta::type<std::shared_ptr<T>>).get();
+}
+
+} // namespace
+
+Symbols::Symbols(const instance::Scope& scope) {
+    // inner scopes shadow the outer ones - only the first found entity is reachable by name
+    auto visited = std::vector<const instance::LocalScope*>{};
+    auto isShadowed = [&](instance::NameView name) {
+        return std::any_of(visited.begin(), visited.end(), [&](auto* inner) { return !inner->byName(name).empty(); });
+    };
+    for (const auto* s = &scope; s != nullptr; s = s->parent.get()) {
+        forEachEntry(*s->locals, [&](const instance::Entry& entry, instance::NameView name, uint64_t index) {
+            if (!isShadowed(name)) addEntry(entry, withStep({}, name, index));
+        });
+        visited.push_back(s->locals.get());
+    }
+}
+
+auto Symbols::pathOf(const void* entity) const -> const SymbolPath* {
+    auto it = m.find(entity);
+    return it != m.end() ? &it->second : nullptr;
+}
+
+void Symbols::addEntry(const instance::Entry& entry, const SymbolPath& path) {
+    entry.visit(
+        [&](const instance::FunctionPtr& function) {
+            m.emplace(function.get(), path);
+            auto index = uint64_t{};
+            for (const auto& parameter : function->parameters) {
+                m.emplace(parameter.get(), withStep(path, parameter->name, index, SymbolKind::parameter));
+                if (parameter->variable != nullptr) {
+                    m.emplace(
+                        parameter->variable,
+                        withStep(path, parameter->name, index, SymbolKind::parameterVariable));
+                }
+                index++;
+            }
+        },
+        [&](const instance::ModulePtr& module) {
+            m.emplace(module.get(), path);
+            forEachEntry(module->locals, [&](const instance::Entry& e, instance::NameView name, uint64_t index) {
+                addEntry(e, withStep(path, name, index));
+            });
+        },
+        [&](const auto& ptr) { m.emplace(ptr.get(), path); });
+}
+
+auto resolveSymbol(const instance::Scope& scope, const SymbolPath& path) -> ResolvedSymbol {
+    auto result = ResolvedSymbol{};
+    result.kind = path.kind;
+    if (path.steps.empty()) return result;
+
+    auto entrySteps = path.steps.size() - (path.kind == SymbolKind::entry ? 0 : 1);
+    const auto& first = path.steps.front();
+    const auto* entry = nth(scope.byName(first.name), first.index);
+    for (auto i = size_t{1}; i < entrySteps && entry != nullptr; i++) {
+        if (!entry->holds<instance::ModulePtr>()) return result;
+        const auto& step = path.steps[i];
+        entry = nth(entry->get<instance::ModulePtr>()->members().byName(step.name), step.index);
+    }
+    if (entry == nullptr) return result;
+    if (path.kind == SymbolKind::entry) {
+        result.entry = entry;
+        return result;
+    }
+    if (!entry->holds<instance::FunctionPtr>()) return result;
+    const auto& parameters = entry->get<instance::FunctionPtr>()->parameters;
+    const auto& last = path.steps.back();
+    if (last.index < parameters.size() && strings::View{parameters[last.index]->name}.isContentEqual(last.name)) {
+        result.parameter = parameters[last.index].get();
+    }
+    return result;
+}
+
+void writeSymbol(Writer& w, const void* entity) {
+    const auto* path = w.symbols() != nullptr ? w.symbols()->pathOf(entity) : nullptr;
+    if (path == nullptr) {
+        w.fail();
+        return;
+    }
+    serialize::write(w, *path);
+}
+
+template<>
+auto readSymbol<instance::Function>(Reader& r) -> const instance::Function* {
+    return readEntry<instance::Function>(r);
+}
+
+template<>
+auto readSymbol<instance::Module>(Reader& r) -> const instance::Module* {
+    return readEntry<instance::Module>(r);
+}
+
+template<>
+auto readSymbol<parser::Type>(Reader& r) -> const parser::Type* {
+    return readEntry<parser::Type>(r);
+}
+
+template<>
+auto readSymbol<instance::Parameter>(Reader& r) -> const instance::Parameter* {
+    auto symbol = readResolved(r);
+    if (!isResolved(symbol, SymbolKind::parameter)) {
+        r.fail();
+        return nullptr;
+    }
+    return symbol.parameter;
+}
+
+template<>
+auto readSymbol<instance::Variable>(Reader& r) -> const instance::Variable* {
+    auto symbol = readResolved(r);
+    if (isResolved(symbol, SymbolKind::parameterVariable)) return symbol.parameter->variable;
+    if (isResolved(symbol, SymbolKind::entry) && symbol.entry->holds<instance::VariablePtr>()) {
+        return symbol.entry->get<instance::VariablePtr>().get();
+    }
+    r.fail();
+    return nullptr;
+}
+
+} // namespace serialize
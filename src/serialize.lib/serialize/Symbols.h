@@ -0,0 +1,121 @@
+#pragma once
+#include "Serializer.h"
+
+#include "instance/Entry.h"
+#include "instance/Scope.h"
+
+#include "meta/Optional.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace serialize {
+
+using Name = strings::String;
+
+/// one step of a symbol path
+struct SymbolStep {
+    Name name{};
+    uint64_t index{}; ///< position among entries with the same name (overloads) or parameter index
+};
+
+enum class SymbolKind : uint8_t {
+    entry, ///< function, variable, type or module
+    parameter, ///< last step is a parameter of the function
+    parameterVariable, ///< variable of that parameter
+};
+
+/// stable path to an entity in a scope tree
+// entities are identified by names, so the path survives a restart of the compiler
+struct SymbolPath {
+    std::vector<SymbolStep> steps{};
+    SymbolKind kind{};
+};
+
+/// digest of the serialized bodies of a function and of all functions it reaches
+struct BodyDigest {
+    uint64_t v[2]{};
+};
+using OptBodyDigest = meta::Optional<BodyDigest>;
+
+/// paths of all entities that are reachable from a scope
+// bodies are expected not to change while the symbols live - their digests are computed once
+// note: not thread safe
+struct Symbols {
+    explicit Symbols(const instance::Scope& scope);
+
+    /// nullptr if the entity is not reachable (eg. shadowed or unknown)
+    [[nodiscard]] auto pathOf(const void* entity) const -> const SymbolPath*;
+
+    /// memoized digest of the function - compute runs on the first request only
+    template<class Compute>
+    auto bodyDigest(instance::FunctionView function, Compute&& compute) const -> OptBodyDigest {
+        auto it = m_bodyDigests.find(function);
+        if (it == m_bodyDigests.end()) it = m_bodyDigests.emplace(function, compute()).first;
+        return it->second;
+    }
+
+private:
+    std::unordered_map<const void*, SymbolPath> m{};
+    mutable std::unordered_map<instance::FunctionView, OptBodyDigest> m_bodyDigests{};
+
+    void addEntry(const instance::Entry& entry, const SymbolPath& path);
+};
+
+struct ResolvedSymbol {
+    const instance::Entry* entry{};
+    instance::ParameterView parameter{};
+    SymbolKind kind{};
+};
+
+/// resolves a path in the scope - entry and parameter are null if nothing matches
+auto resolveSymbol(const instance::Scope& scope, const SymbolPath& path) -> ResolvedSymbol;
+
+template<>
+struct Serializer<SymbolStep> {
+    static void write(Writer& w, const SymbolStep& step) {
+        serialize::write(w, step.name);
+        w.varint(step.index);
+    }
+    static auto read(Reader& r) -> SymbolStep {
+        auto step = SymbolStep{};
+        step.name = serialize::read<Name>(r);
+        step.index = r.varint();
+        return step;
+    }
+};
+
+template<>
+struct Serializer<SymbolPath> {
+    static void write(Writer& w, const SymbolPath& path) {
+        w.enumValue(path.kind);
+        serialize::write(w, path.steps);
+    }
+    static auto read(Reader& r) -> SymbolPath {
+        auto path = SymbolPath{};
+        path.kind = r.enumValue<SymbolKind>();
+        path.steps = serialize::read<std::vector<SymbolStep>>(r);
+        return path;
+    }
+};
+
+/// writes the symbol path of the entity (fails the writer if it is not reachable)
+void writeSymbol(Writer& w, const void* entity);
+
+/// reads a symbol path and resolves it with the scope of the reader
+// returns nullptr and fails the reader if the path does not resolve to a T
+template<class T>
+auto readSymbol(Reader& r) -> const T*;
+
+template<>
+auto readSymbol<instance::Function>(Reader& r) -> const instance::Function*;
+template<>
+auto readSymbol<instance::Parameter>(Reader& r) -> const instance::Parameter*;
+template<>
+auto readSymbol<instance::Variable>(Reader& r) -> const instance::Variable*;
+template<>
+auto readSymbol<instance::Module>(Reader& r) -> const instance::Module*;
+template<>
+auto readSymbol<parser::Type>(Reader& r) -> const parser::Type*;
+
+} // namespace serialize
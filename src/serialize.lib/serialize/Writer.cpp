@@ -0,0 +1,43 @@
+#include "Writer.h"
+
+namespace serialize {
+
+void Writer::varint(uint64_t v) {
+    while (v >= 0x80u) {
+        byte(static_cast<uint8_t>(v | 0x80u));
+        v >>= 7u;
+    }
+    byte(static_cast<uint8_t>(v));
+}
+
+void Writer::bytes(View v) {
+    varint(v.size());
+    m_bytes.insert(m_bytes.end(), v.begin(), v.end());
+}
+
+// view encoding:
+// 0 - null view
+// 1 - offset & size in source
+// 2 - inline bytes
+void Writer::view(View v) {
+    if (v.begin() == nullptr) {
+        byte(0);
+    }
+    else if (!m_source.isEmpty() && v.isPartOf(m_source)) {
+        byte(1);
+        varint(static_cast<uint64_t>(v.begin() - m_source.begin()));
+        varint(v.size());
+    }
+    else {
+        byte(2);
+        bytes(v);
+    }
+}
+
+auto Writer::referenceIndex(const void* target) const -> meta::Optional<uint64_t> {
+    auto it = m_references.find(target);
+    if (it == m_references.end()) return {};
+    return it->second;
+}
+
+} // namespace serialize
@@ -0,0 +1,58 @@
+#pragma once
+#include "strings/View.h"
+
+#include "meta/Optional.h"
+
+#include <cinttypes>
+#include <unordered_map>
+#include <vector>
+
+namespace serialize {
+
+using strings::View;
+using Bytes = std::vector<uint8_t>;
+
+struct Symbols;
+
+/// appends a compact binary encoding to a byte buffer
+// views into the source text are stored as offsets, so the reader can restore them in place
+struct Writer {
+    using This = Writer;
+
+    explicit Writer(View source, const Symbols* symbols = {})
+        : m_source(source)
+        , m_symbols(symbols) {}
+
+    void byte(uint8_t v) { m_bytes.push_back(v); }
+    void varint(uint64_t v); ///< LEB128 - small values use a single byte
+    void flag(bool v) { byte(v ? 1 : 0); }
+    void bytes(View v);
+    void view(View v);
+
+    template<class E>
+    void enumValue(E e) {
+        varint(static_cast<uint64_t>(e));
+    }
+
+    /// numbers the local references (eg. NameTypeValue) in order of definition
+    void defineReference(const void* target) { m_references.emplace(target, m_references.size()); }
+    [[nodiscard]] auto referenceIndex(const void* target) const -> meta::Optional<uint64_t>;
+
+    [[nodiscard]] auto source() const -> View { return m_source; }
+    [[nodiscard]] auto symbols() const -> const Symbols* { return m_symbols; }
+
+    /// marks the output as unusable (eg. a symbol is not reachable)
+    void fail() { m_failed = true; }
+    [[nodiscard]] bool failed() const { return m_failed; }
+
+    [[nodiscard]] auto take() && -> Bytes { return std::move(m_bytes); }
+
+private:
+    View m_source{};
+    const Symbols* m_symbols{};
+    Bytes m_bytes{};
+    std::unordered_map<const void*, uint64_t> m_references{};
+    bool m_failed{};
+};
+
+} // namespace serialize
@@ -0,0 +1,27 @@
+#include "nesting.h"
+
+namespace serialize {
+
+void Serializer<nesting::BlockLine>::write(Writer& w, const nesting::BlockLine& line) {
+    serialize::write(w, line.tokens);
+    serialize::write(w, line.insignificants);
+}
+
+auto Serializer<nesting::BlockLine>::read(Reader& r) -> nesting::BlockLine {
+    auto line = nesting::BlockLine{};
+    line.tokens = serialize::read<std::vector<nesting::Token>>(r);
+    line.insignificants = serialize::read<std::vector<nesting::Insignificant>>(r);
+    return line;
+}
+
+void Serializer<nesting::BlockLiteralValue>::write(Writer& w, const nesting::BlockLiteralValue& v) {
+    serialize::write(w, *v.lines);
+}
+
+auto Serializer<nesting::BlockLiteralValue>::read(Reader& r) -> nesting::BlockLiteralValue {
+    auto v = nesting::BlockLiteralValue{};
+    v.lines = serialize::read<nesting::BlockLines>(r);
+    return v;
+}
+
+} // namespace serialize
@@ -0,0 +1,191 @@
+#pragma once
+#include "Serializer.h"
+
+#include "nesting/Token.h"
+
+namespace serialize {
+
+namespace details {
+
+inline void writeInputPosition(Writer& w, const text::InputPositionData& ip) {
+    w.view(ip.input);
+    serialize::write(w, ip.position);
+}
+inline void readInputPosition(Reader& r, text::InputPositionData& ip) {
+    ip.input = r.view();
+    ip.position = serialize::read<text::Position>(r);
+}
+
+} // namespace details
+
+template<class... Tags>
+struct Serializer<text::InputPosition<Tags...>> {
+    using T = text::InputPosition<Tags...>;
+    static void write(Writer& w, const T& t) { details::writeInputPosition(w, t); }
+    static auto read(Reader& r) -> T {
+        auto t = T{};
+        details::readInputPosition(r, t);
+        return t;
+    }
+};
+
+template<class... Tags>
+struct Serializer<scanner::details::TagToken<Tags...>> {
+    using T = scanner::details::TagToken<Tags...>;
+    static void write(Writer& w, const T& t) {
+        details::writeInputPosition(w, t);
+        w.flag(t.isTainted);
+    }
+    static auto read(Reader& r) -> T {
+        auto t = T{};
+        details::readInputPosition(r, t);
+        t.isTainted = r.flag();
+        return t;
+    }
+};
+
+template<class... Tags>
+struct Serializer<scanner::details::TagErrorToken<Tags...>> {
+    using T = scanner::details::TagErrorToken<Tags...>;
+    static void write(Writer& w, const T& t) {
+        details::writeInputPosition(w, t);
+        w.flag(t.isTainted);
+    }
+    static auto read(Reader& r) -> T {
+        auto t = T{};
+        details::readInputPosition(r, t);
+        t.isTainted = r.flag();
+        return t;
+    }
+};
+
+template<class... Tags>
+struct Serializer<scanner::details::TagTokenWithDecodeErrors<Tags...>> {
+    using T = scanner::details::TagTokenWithDecodeErrors<Tags...>;
+    static void write(Writer& w, const T& t) {
+        details::writeInputPosition(w, t);
+        serialize::write(w, t.decodeErrors);
+        w.flag(t.isTainted);
+    }
+    static auto read(Reader& r) -> T {
+        auto t = T{};
+        details::readInputPosition(r, t);
+        t.decodeErrors = serialize::read<scanner::DecodedErrorPositions>(r);
+        t.isTainted = r.flag();
+        return t;
+    }
+};
+
+template<class Value>
+struct Serializer<scanner::details::ValueToken<Value>> {
+    using T = scanner::details::ValueToken<Value>;
+    static void write(Writer& w, const T& t) {
+        details::writeInputPosition(w, t);
+        serialize::write(w, t.value);
+        w.flag(t.isTainted);
+    }
+    static auto read(Reader& r) -> T {
+        auto t = T{};
+        details::readInputPosition(r, t);
+        t.value = serialize::read<Value>(r);
+        t.isTainted = r.flag();
+        return t;
+    }
+};
+
+template<>
+struct Serializer<scanner::NewLineIndentationValue> {
+    static void write(Writer& w, const scanner::NewLineIndentationValue& v) {
+        serialize::write(w, v.errors);
+        serialize::write(w, v.indentColumn);
+    }
+    static auto read(Reader& r) -> scanner::NewLineIndentationValue {
+        auto v = scanner::NewLineIndentationValue{};
+        v.errors = serialize::read<scanner::NewLineIndentErrors>(r);
+        v.indentColumn = serialize::read<text::Column>(r);
+        return v;
+    }
+};
+
+template<>
+struct Serializer<scanner::StringError> {
+    static void write(Writer& w, const scanner::StringError& e) {
+        w.enumValue(e.kind);
+        w.view(e.input);
+        serialize::write(w, e.position);
+    }
+    static auto read(Reader& r) -> scanner::StringError {
+        auto e = scanner::StringError{};
+        e.kind = r.enumValue<scanner::StringError::Kind>();
+        e.input = r.view();
+        e.position = serialize::read<text::Position>(r);
+        return e;
+    }
+};
+
+template<>
+struct Serializer<scanner::StringLiteralValue> {
+    static void write(Writer& w, const scanner::StringLiteralValue& v) {
+        serialize::write(w, v.text);
+        serialize::write(w, v.errors);
+    }
+    static auto read(Reader& r) -> scanner::StringLiteralValue {
+        auto v = scanner::StringLiteralValue{};
+        v.text = serialize::read<strings::Rope>(r);
+        v.errors = serialize::read<scanner::StringErrors>(r);
+        return v;
+    }
+};
+
+template<>
+struct Serializer<scanner::NumberLiteralValue> {
+    static void write(Writer& w, const scanner::NumberLiteralValue& v) {
+        w.enumValue(v.radix);
+        serialize::write(w, v.integerPart);
+        serialize::write(w, v.fractionalPart);
+        w.enumValue(v.exponentSign);
+        serialize::write(w, v.exponentPart);
+        serialize::write(w, v.errors);
+    }
+    static auto read(Reader& r) -> scanner::NumberLiteralValue {
+        auto v = scanner::NumberLiteralValue{};
+        v.radix = r.enumValue<scanner::Radix>();
+        v.integerPart = serialize::read<strings::Rope>(r);
+        v.fractionalPart = serialize::read<strings::Rope>(r);
+        v.exponentSign = r.enumValue<scanner::Sign>();
+        v.exponentPart = serialize::read<strings::Rope>(r);
+        v.errors = serialize::read<scanner::NumberLiteralErrors>(r);
+        return v;
+    }
+};
+
+template<>
+struct Serializer<scanner::IdentifierLiteralValue> {
+    static void write(Writer& w, const scanner::IdentifierLiteralValue& v) {
+        w.enumValue(v.type);
+        serialize::write(w, v.errors);
+    }
+    static auto read(Reader& r) -> scanner::IdentifierLiteralValue {
+        auto v = scanner::IdentifierLiteralValue{};
+        v.type = r.enumValue<scanner::IdentifierLiteralType>();
+        v.errors = serialize::read<scanner::IdentifierLiteralErrors>(r);
+        return v;
+    }
+};
+
+template<>
+struct Serializer<nesting::Token> : DerivedVariantSerializer<nesting::Token, nesting::TokenVariant> {};
+
+template<>
+struct Serializer<nesting::BlockLine> {
+    static void write(Writer& w, const nesting::BlockLine& line);
+    static auto read(Reader& r) -> nesting::BlockLine;
+};
+
+template<>
+struct Serializer<nesting::BlockLiteralValue> {
+    static void write(Writer& w, const nesting::BlockLiteralValue& v);
+    static auto read(Reader& r) -> nesting::BlockLiteralValue;
+};
+
+} // namespace serialize
@@ -0,0 +1,206 @@
+#include "parser.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace serialize {
+
+namespace {
+
+struct RegisteredType {
+    std::weak_ptr<const parser::Type> type; // expired entries belong to a destroyed type at the same address
+    TypeSerializer serializer;
+};
+
+struct TypeRegistry {
+    std::mutex mutex;
+    std::unordered_map<parser::TypeView, RegisteredType> map;
+};
+
+auto typeRegistry() -> TypeRegistry& {
+    static auto registry = TypeRegistry{};
+    return registry;
+}
+
+} // namespace
+
+void registerType(const instance::TypePtr& type, TypeSerializer serializer) {
+    auto& registry = typeRegistry();
+    auto lock = std::lock_guard{registry.mutex};
+    std::erase_if(registry.map, [](const auto& entry) { return entry.second.type.expired(); });
+    registry.map[type.get()] = RegisteredType{type, serializer};
+}
+
+auto typeSerializer(parser::TypeView type) -> TypeSerializer {
+    auto& registry = typeRegistry();
+    auto lock = std::lock_guard{registry.mutex};
+    auto it = registry.map.find(type);
+    if (it == registry.map.end() || it->second.type.expired()) return {};
+    return it->second.serializer;
+}
+
+void Serializer<parser::Value>::write(Writer& w, const parser::Value& value) {
+    auto type = value.type();
+    w.flag(type != nullptr);
+    if (type == nullptr) return;
+    auto serializer = typeSerializer(type);
+    if (serializer.write == nullptr) {
+        w.fail(); // no serializer registered
+        return;
+    }
+    writeSymbol(w, type);
+    serializer.write(w, value.data());
+}
+
+auto Serializer<parser::Value>::read(Reader& r) -> parser::Value {
+    if (!r.flag()) return {};
+    auto type = readSymbol<parser::Type>(r);
+    auto serializer = typeSerializer(type);
+    if (type == nullptr || serializer.read == nullptr) {
+        r.fail();
+        return {};
+    }
+    auto value = parser::Value{type};
+    serializer.read(r, value.data());
+    return value;
+}
+
+void Serializer<parser::Block>::write(Writer& w, const parser::Block& block) { serialize::write(w, block.expressions); }
+
+auto Serializer<parser::Block>::read(Reader& r) -> parser::Block {
+    return parser::Block{serialize::read<parser::VecOfBlockExpr>(r)};
+}
+
+// references are numbered in order of the NameTypeValue definitions
+void Serializer<parser::NameTypeValueReference>::write(Writer& w, const parser::NameTypeValueReference& ref) {
+    auto index = w.referenceIndex(ref.nameTypeValue);
+    if (!index) {
+        w.fail(); // reference to outside of the serialized tree
+        return;
+    }
+    w.varint(index.value());
+}
+
+auto Serializer<parser::NameTypeValueReference>::read(Reader& r) -> parser::NameTypeValueReference {
+    auto target = r.reference(r.varint());
+    return parser::NameTypeValueReference{static_cast<parser::NameTypeValueView>(target)};
+}
+
+void Serializer<parser::VariableReference>::write(Writer& w, const parser::VariableReference& ref) {
+    writeSymbol(w, ref.variable);
+}
+
+auto Serializer<parser::VariableReference>::read(Reader& r) -> parser::VariableReference {
+    return parser::VariableReference{readSymbol<instance::Variable>(r)};
+}
+
+void Serializer<parser::TypeReference>::write(Writer& w, const parser::TypeReference& ref) {
+    writeSymbol(w, ref.type);
+}
+
+auto Serializer<parser::TypeReference>::read(Reader& r) -> parser::TypeReference {
+    return parser::TypeReference{readSymbol<parser::Type>(r)};
+}
+
+void Serializer<parser::ArgumentAssignment>::write(Writer& w, const parser::ArgumentAssignment& assign) {
+    writeSymbol(w, assign.parameter);
+    serialize::write(w, assign.values);
+}
+
+auto Serializer<parser::ArgumentAssignment>::read(Reader& r) -> parser::ArgumentAssignment {
+    auto assign = parser::ArgumentAssignment{};
+    assign.parameter = readSymbol<instance::Parameter>(r);
+    assign.values = serialize::read<parser::VecOfValueExpr>(r);
+    return assign;
+}
+
+void Serializer<parser::Call>::write(Writer& w, const parser::Call& call) {
+    writeSymbol(w, call.function);
+    serialize::write(w, call.arguments);
+}
+
+auto Serializer<parser::Call>::read(Reader& r) -> parser::Call {
+    auto call = parser::Call{};
+    call.function = readSymbol<instance::Function>(r);
+    call.arguments = serialize::read<parser::ArgumentAssignments>(r);
+    return call;
+}
+
+void Serializer<parser::ModuleReference>::write(Writer& w, const parser::ModuleReference& ref) {
+    writeSymbol(w, ref.module);
+}
+
+auto Serializer<parser::ModuleReference>::read(Reader& r) -> parser::ModuleReference {
+    return parser::ModuleReference{readSymbol<instance::Module>(r)};
+}
+
+void Serializer<parser::ModuleInit>::write(Writer& w, const parser::ModuleInit& init) {
+    writeSymbol(w, init.module);
+    serialize::write(w, init.nodes);
+}
+
+auto Serializer<parser::ModuleInit>::read(Reader& r) -> parser::ModuleInit {
+    auto init = parser::ModuleInit{};
+    init.module = readSymbol<instance::Module>(r);
+    init.nodes = serialize::read<parser::VecOfInitExpr>(r);
+    return init;
+}
+
+void Serializer<parser::VariableInit>::write(Writer& w, const parser::VariableInit& init) {
+    writeSymbol(w, init.variable);
+    serialize::write(w, init.nodes);
+}
+
+auto Serializer<parser::VariableInit>::read(Reader& r) -> parser::VariableInit {
+    auto init = parser::VariableInit{};
+    init.variable = readSymbol<instance::Variable>(r);
+    init.nodes = serialize::read<parser::VecOfValueExpr>(r);
+    return init;
+}
+
+void Serializer<parser::NameTypeValueTuple>::write(Writer& w, const parser::NameTypeValueTuple& tuple) {
+    w.varint(tuple.tuple->size());
+    for (const auto& ntv : *tuple.tuple) serialize::write(w, ntv);
+}
+
+// entries are read in place, so references to them stay valid
+auto Serializer<parser::NameTypeValueTuple>::read(Reader& r) -> parser::NameTypeValueTuple {
+    auto tuple = parser::NameTypeValueTuple{};
+    auto count = r.count();
+    for (auto i = uint64_t{}; i < count && !r.failed(); i++) {
+        auto& ntv = tuple.tuple.modify().emplace_back();
+        r.defineReference(&ntv);
+        ntv.name = serialize::read<parser::OptName>(r);
+        ntv.type = serialize::read<parser::OptTypeExpr>(r);
+        ntv.value = serialize::read<parser::OptValueExpr>(r);
+    }
+    return tuple;
+}
+
+void Serializer<parser::ScopedBlockLiteral>::write(Writer& w, const parser::ScopedBlockLiteral& block) {
+    serialize::write(w, block.block);
+}
+
+auto Serializer<parser::ScopedBlockLiteral>::read(Reader& r) -> parser::ScopedBlockLiteral {
+    return parser::ScopedBlockLiteral{serialize::read<nesting::BlockLiteral>(r)};
+}
+
+void Serializer<parser::NameTypeValue>::write(Writer& w, const parser::NameTypeValue& ntv) {
+    w.defineReference(&ntv);
+    serialize::write(w, ntv.name);
+    serialize::write(w, ntv.type);
+    serialize::write(w, ntv.value);
+}
+
+// note: NameTypeValues outside of a tuple cannot be referenced
+auto Serializer<parser::NameTypeValue>::read(Reader& r) -> parser::NameTypeValue {
+    r.defineReference(nullptr);
+    auto ntv = parser::NameTypeValue{};
+    ntv.name = serialize::read<parser::OptName>(r);
+    ntv.type = serialize::read<parser::OptTypeExpr>(r);
+    ntv.value = serialize::read<parser::OptValueExpr>(r);
+    return ntv;
+}
+
+} // namespace serialize
@@ -0,0 +1,92 @@
+#pragma once
+#include "Symbols.h"
+#include "nesting.h"
+
+#include "parser/Expression.h"
+
+#include "meta/Same.h"
+
+namespace serialize {
+
+/// values are written with the serializer registered in their type
+template<>
+struct Serializer<parser::Value> {
+    static void write(Writer& w, const parser::Value& value);
+    static auto read(Reader& r) -> parser::Value;
+};
+
+#define SERIALIZE_DECLARE(T)                                                                                           \
+    template<>                                                                                                         \
+    struct Serializer<T> {                                                                                             \
+        static void write(Writer& w, const T& v);                                                                      \
+        static auto read(Reader& r) -> T;                                                                              \
+    };
+
+SERIALIZE_DECLARE(parser::Block)
+SERIALIZE_DECLARE(parser::NameTypeValueReference)
+SERIALIZE_DECLARE(parser::VariableReference)
+SERIALIZE_DECLARE(parser::TypeReference)
+SERIALIZE_DECLARE(parser::ArgumentAssignment)
+SERIALIZE_DECLARE(parser::Call)
+SERIALIZE_DECLARE(parser::ModuleReference)
+SERIALIZE_DECLARE(parser::ModuleInit)
+SERIALIZE_DECLARE(parser::VariableInit)
+SERIALIZE_DECLARE(parser::NameTypeValueTuple)
+SERIALIZE_DECLARE(parser::ScopedBlockLiteral)
+SERIALIZE_DECLARE(parser::NameTypeValue)
+
+#undef SERIALIZE_DECLARE
+
+template<>
+struct Serializer<parser::TypeExpr> : DerivedVariantSerializer<parser::TypeExpr, parser::TypeExprVariant> {};
+template<>
+struct Serializer<parser::InitExpr> : DerivedVariantSerializer<parser::InitExpr, parser::InitExprVariant> {};
+template<>
+struct Serializer<parser::ValueExpr> : DerivedVariantSerializer<parser::ValueExpr, parser::ValueExprVariant> {};
+template<>
+struct Serializer<parser::BlockExpr> : DerivedVariantSerializer<parser::BlockExpr, parser::BlockExprVariant> {};
+template<>
+struct Serializer<parser::PartiallyParsed>
+    : DerivedVariantSerializer<parser::PartiallyParsed, parser::PartiallyParsedVariant> {};
+
+/// compile time values that point to instances
+template<class T>
+struct Serializer<T*, std::enable_if_t<meta::same<T, instance::Module> || meta::same<T, instance::Function>>> {
+    static void write(Writer& w, const T* v) { writeSymbol(w, v); }
+    static auto read(Reader& r) -> T* { return const_cast<T*>(readSymbol<T>(r)); }
+};
+template<>
+struct Serializer<parser::Type*> {
+    static void write(Writer& w, const parser::Type* v) { writeSymbol(w, v); }
+    static auto read(Reader& r) -> parser::Type* { return const_cast<parser::Type*>(readSymbol<parser::Type>(r)); }
+};
+
+/// serializer functions for the values of one type
+// optional - values of types without serializer prevent caching
+struct TypeSerializer {
+    using WriteFunc = void(Writer&, const void* source);
+    using ReadFunc = void(Reader&, void* dest);
+
+    WriteFunc* write{};
+    ReadFunc* read{};
+};
+
+/// registers the serializer of a type - the entry is dropped with the type
+void registerType(const instance::TypePtr& type, TypeSerializer serializer);
+/// serializer of a type - empty if none was registered
+auto typeSerializer(parser::TypeView type) -> TypeSerializer;
+
+/// registers the serializer for values of type T (used by the intrinsic adapter)
+template<class T>
+void registerType(const instance::TypePtr& type) {
+    registerType(
+        type,
+        TypeSerializer{
+            [](Writer& w, const void* source) {
+                serialize::write(w, *std::launder(reinterpret_cast<const T*>(source)));
+            },
+            [](Reader& r, void* dest) { *std::launder(reinterpret_cast<T*>(dest)) = serialize::read<T>(r); },
+        });
+}
+
+} // namespace serialize